@@ -0,0 +1,125 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <cstdint>
+#include <vector>
+
+// Build option (OXIDE_PACK_LANE_STATE in CMake): off, ChannelLaneBlock leaves
+// every lane in its own heap block, so the packing can be A/B'd with perf stat
+#ifndef OXIDE_PACK_LANE_STATE
+#define OXIDE_PACK_LANE_STATE 1
+#endif
+
+/**
+    One value per channel, stored lane-wise and padded to whole SIMD registers
+    so groups of channels can be processed together (4 lanes on SSE/NEON, 8 on
+    AVX). Use group() for register-wide maths and operator[] for per-channel
+    work that doesn't vectorise (random triggers, table lookups, delay reads).
+
+    Lanes either own their storage (resize) or live in a ChannelLaneBlock shared
+    with the rest of the per-sample state (bind). Sized in prepareToPlay; never
+    reallocates on the audio thread.
+*/
+template <typename SampleType>
+class ChannelLanes
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int kLanes = static_cast<int>(Vec::size());
+
+    ChannelLanes() = default;
+
+    static int getNumGroupsFor(int numChannels) noexcept { return (numChannels + kLanes - 1) / kLanes; }
+
+    void resize(int numChannels)
+    {
+        owned.assign(static_cast<size_t>(getNumGroupsFor(numChannels)), Vec::expand(SampleType(0)));
+        groups = owned.data();
+        numGroups = static_cast<int>(owned.size());
+    }
+
+    /** Points the lanes at storage owned elsewhere (see ChannelLaneBlock). */
+    void bind(Vec* storage, int groupCount) noexcept
+    {
+        owned = {};
+        groups = storage;
+        numGroups = groupCount;
+    }
+
+    void fill(SampleType value)
+    {
+        for (int g = 0; g < numGroups; ++g)
+            groups[g] = Vec::expand(value);
+    }
+
+    int getNumGroups() const noexcept { return numGroups; }
+
+    Vec& group(int index) noexcept { return groups[index]; }
+    const Vec& group(int index) const noexcept { return groups[index]; }
+
+    SampleType& operator[](int channel) noexcept { return reinterpret_cast<SampleType*>(groups)[channel]; }
+    SampleType operator[](int channel) const noexcept { return reinterpret_cast<const SampleType*>(groups)[channel]; }
+
+private:
+    std::vector<Vec> owned;
+    Vec* groups = nullptr;
+    int numGroups = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(ChannelLanes)
+};
+
+/**
+    Packs several ChannelLanes back to back in one cache-line-aligned block, so
+    state the sample loop touches together sits together: a stereo chain's
+    whole per-sample state spans a handful of lines instead of one scattered
+    heap block per variable. Current values are carried over when packing.
+*/
+template <typename SampleType>
+class ChannelLaneBlock
+{
+public:
+    using Vec = typename ChannelLanes<SampleType>::Vec;
+    static constexpr std::uintptr_t kCacheLineBytes = 64;
+
+    void allocate(std::vector<ChannelLanes<SampleType>*> lanesToPack, int numChannels)
+    {
+#if ! OXIDE_PACK_LANE_STATE
+        for (auto* lanes : lanesToPack)
+            lanes->resize(numChannels);
+#else
+        const int groupsPerLanes = ChannelLanes<SampleType>::getNumGroupsFor(numChannels);
+        const auto padding = static_cast<size_t>(kCacheLineBytes / sizeof(Vec));
+
+        std::vector<Vec> newStorage(lanesToPack.size() * static_cast<size_t>(groupsPerLanes) + padding,
+                                    Vec::expand(SampleType(0)));
+
+        const auto address = reinterpret_cast<std::uintptr_t>(newStorage.data());
+        auto* base = reinterpret_cast<Vec*>((address + kCacheLineBytes - 1) & ~(kCacheLineBytes - 1));
+
+        for (auto* lanes : lanesToPack)
+        {
+            for (int g = 0; g < juce::jmin(groupsPerLanes, lanes->getNumGroups()); ++g)
+                base[g] = lanes->group(g);
+
+            lanes->bind(base, groupsPerLanes);
+            base += groupsPerLanes;
+        }
+
+        storage = std::move(newStorage);
+        packed = std::move(lanesToPack);
+#endif
+    }
+
+    void release()
+    {
+        for (auto* lanes : packed)
+            lanes->bind(nullptr, 0);
+
+        packed = {};
+        storage = {};
+    }
+
+private:
+    std::vector<Vec> storage;
+    std::vector<ChannelLanes<SampleType>*> packed;
+};
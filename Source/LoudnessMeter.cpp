@@ -0,0 +1,435 @@
+#include "LoudnessMeter.h"
+
+namespace
+{
+    float toLufs(double power) noexcept
+    {
+        if (power <= 0.0)
+            return LoudnessMeter::kFloorDb;
+
+        return juce::jmax(LoudnessMeter::kFloorDb, static_cast<float>(-0.691 + 10.0 * std::log10(power)));
+    }
+
+    template <typename SampleType>
+    void copySamples(float* destination, const SampleType* source, int numSamples) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            juce::FloatVectorOperations::copy(destination, source, numSamples);
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = static_cast<float>(source[i]);
+        }
+    }
+}
+
+LoudnessMeter::LoudnessMeter()
+    : juce::Thread("Oxide Loudness")
+{
+}
+
+LoudnessMeter::~LoudnessMeter()
+{
+    release();
+}
+
+void LoudnessMeter::prepare(double newSampleRate, int maxBlockSize, std::vector<float> channelWeights)
+{
+    release();
+
+    sampleRate = newSampleRate;
+    weights = std::move(channelWeights);
+    numChannels = static_cast<int>(weights.size());
+    subBlockLength = juce::jmax(1, juce::roundToInt(sampleRate / 10.0));
+
+    // Half a second of backlog, and always a few blocks' worth
+    const int capacity = juce::jmax(maxBlockSize * 4, juce::roundToInt(sampleRate / 2.0)) + 1;
+    fifo.setTotalSize(capacity);
+    fifoBuffer.setSize(2 * numChannels, capacity);
+
+    // K-weighting (BS.1770-4): a high shelf for the head, then the RLB highpass,
+    // from the analogue prototypes so any sample rate gets the same response
+    ChannelState prototype;
+    {
+        const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        auto& shelf = prototype.shelf;
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+    {
+        const double f0 = 38.13547087602444, q = 0.5003270373238773;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        auto& highpass = prototype.highpass;
+        highpass.b0 = 1.0;
+        highpass.b1 = -2.0;
+        highpass.b2 = 1.0;
+        highpass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highpass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    for (auto& side : sides)
+        side.channels.assign(static_cast<size_t>(numChannels), prototype);
+
+    // True peak: a 48-tap windowed-sinc interpolator like the one in BS.1770
+    // Annex 2, split into one 12-tap phase per quarter-sample position (phase 0
+    // reduces to the delayed sample itself), each normalised to unity gain
+    constexpr int numTaps = kOversampling * kTapsPerPhase;
+    constexpr double centre = numTaps / 2.0;
+
+    for (int p = 0; p < kOversampling; ++p)
+    {
+        auto& phase = phaseCoefficients[static_cast<size_t>(p)];
+        double sum = 0.0;
+
+        for (int j = 0; j < kTapsPerPhase; ++j)
+        {
+            const int tap = p + kOversampling * j;
+            const double t = (tap - centre) / kOversampling;
+            const double x = juce::MathConstants<double>::pi * t;
+            const double w = static_cast<double>(tap) / numTaps;
+            const double blackman = 0.42 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * w)
+                                  + 0.08 * std::cos(2.0 * juce::MathConstants<double>::twoPi * w);
+
+            phase[static_cast<size_t>(j)] = (2 * tap == numTaps ? 1.0 : std::sin(x) / x) * blackman;
+            sum += phase[static_cast<size_t>(j)];
+        }
+
+        for (auto& c : phase)
+            c /= sum;
+    }
+
+    subBlockPos = 0;
+    writePending = false;
+    resetRequested.store(false, std::memory_order_relaxed);
+
+    for (auto& side : sides)
+    {
+        side.subBlockSum = 0.0;
+        side.numSubBlocks = 0;
+        side.nextSubBlock = 0;
+    }
+
+    clearMeasurements();
+
+    for (auto& reading : published)
+    {
+        reading.momentary.store(kFloorDb, std::memory_order_relaxed);
+        reading.shortTerm.store(kFloorDb, std::memory_order_relaxed);
+    }
+
+    if (numChannels > 0)
+        startThread(juce::Thread::Priority::low);
+}
+
+std::vector<float> LoudnessMeter::getChannelWeights(const juce::AudioChannelSet& layout, int numChannels)
+{
+    std::vector<float> channelWeights(static_cast<size_t>(juce::jmax(0, numChannels)), 1.0f);
+
+    constexpr juce::AudioChannelSet::ChannelType surrounds[] = {
+        juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::rightSurround,
+        juce::AudioChannelSet::leftSurroundSide, juce::AudioChannelSet::rightSurroundSide,
+        juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::rightSurroundRear
+    };
+
+    for (int ch = 0; ch < juce::jmin(numChannels, layout.size()); ++ch)
+    {
+        const auto type = layout.getTypeOfChannel(ch);
+        auto& weight = channelWeights[static_cast<size_t>(ch)];
+
+        if (type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2)
+            weight = 0.0f;
+        else if (std::find(std::begin(surrounds), std::end(surrounds), type) != std::end(surrounds))
+            weight = 1.41f;
+    }
+
+    return channelWeights;
+}
+
+void LoudnessMeter::release()
+{
+    stopThread(1000);
+}
+
+// =============================================================================
+// AUDIO THREAD
+// =============================================================================
+
+template <typename SampleType>
+void LoudnessMeter::copyIn(const juce::AudioBuffer<SampleType>& buffer, int firstChannel) noexcept
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* destination = fifoBuffer.getWritePointer(firstChannel + ch);
+
+        if (ch < buffer.getNumChannels())
+        {
+            const SampleType* source = buffer.getReadPointer(ch);
+            copySamples(destination + writeStart1, source, writeSize1);
+            copySamples(destination + writeStart2, source + writeSize1, writeSize2);
+        }
+        else
+        {
+            juce::FloatVectorOperations::clear(destination + writeStart1, writeSize1);
+            juce::FloatVectorOperations::clear(destination + writeStart2, writeSize2);
+        }
+    }
+}
+
+template <typename SampleType>
+void LoudnessMeter::pushInput(const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    writePending = false;
+
+    const int numSamples = buffer.getNumSamples();
+    if (numChannels == 0 || numSamples <= 0)
+        return;
+
+    // The region stays reserved until the output half is written; if the worker
+    // has fallen that far behind, the block goes unmeasured
+    fifo.prepareToWrite(numSamples, writeStart1, writeSize1, writeStart2, writeSize2);
+    if (writeSize1 + writeSize2 < numSamples)
+        return;
+
+    copyIn(buffer, 0);
+    writePending = true;
+}
+
+template <typename SampleType>
+void LoudnessMeter::pushOutput(const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    if (! writePending)
+        return;
+
+    copyIn(buffer, numChannels);
+    fifo.finishedWrite(writeSize1 + writeSize2);
+    writePending = false;
+}
+
+template void LoudnessMeter::pushInput<float>(const juce::AudioBuffer<float>&) noexcept;
+template void LoudnessMeter::pushInput<double>(const juce::AudioBuffer<double>&) noexcept;
+template void LoudnessMeter::pushOutput<float>(const juce::AudioBuffer<float>&) noexcept;
+template void LoudnessMeter::pushOutput<double>(const juce::AudioBuffer<double>&) noexcept;
+
+// =============================================================================
+// WORKER
+// =============================================================================
+
+void LoudnessMeter::run()
+{
+    while (! threadShouldExit())
+    {
+        if (resetRequested.exchange(false, std::memory_order_acquire))
+            clearMeasurements();
+
+        const int ready = fifo.getNumReady();
+        if (ready == 0)
+        {
+            wait(kPollMs);
+            continue;
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(ready, start1, size1, start2, size2);
+        processFrames(start1, size1);
+        processFrames(start2, size2);
+        fifo.finishedRead(size1 + size2);
+    }
+}
+
+void LoudnessMeter::processFrames(int start, int numFrames)
+{
+    int done = 0;
+
+    while (done < numFrames)
+    {
+        const int length = juce::jmin(numFrames - done, subBlockLength - subBlockPos);
+
+        for (int s = 0; s < 2; ++s)
+        {
+            auto& side = sides[static_cast<size_t>(s)];
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float* data = fifoBuffer.getReadPointer(s * numChannels + ch, start + done);
+                auto& channel = side.channels[static_cast<size_t>(ch)];
+                double sum = 0.0;
+
+                for (int i = 0; i < length; ++i)
+                {
+                    const double x = data[i];
+                    const double weighted = channel.highpass.process(channel.shelf.process(x));
+                    sum += weighted * weighted;
+                    channel.peak = juce::jmax(channel.peak, truePeakSample(channel, x));
+                }
+
+                side.subBlockSum += weights[static_cast<size_t>(ch)] * sum;
+            }
+        }
+
+        done += length;
+        subBlockPos += length;
+
+        if (subBlockPos == subBlockLength)
+        {
+            subBlockPos = 0;
+            for (int s = 0; s < 2; ++s)
+                finishSubBlock(sides[static_cast<size_t>(s)], published[static_cast<size_t>(s)]);
+        }
+    }
+}
+
+double LoudnessMeter::truePeakSample(ChannelState& channel, double x) const noexcept
+{
+    const auto pos = static_cast<size_t>(channel.historyPos);
+    channel.history[pos] = channel.history[pos + kTapsPerPhase] = x;
+    channel.historyPos = (channel.historyPos + 1) % kTapsPerPhase;
+
+    // Oldest to newest; tap j of each phase multiplies the sample j steps back
+    const double* window = channel.history.data() + channel.historyPos;
+    double peak = std::abs(x);
+
+    for (const auto& phase : phaseCoefficients)
+    {
+        double y = 0.0;
+        for (int j = 0; j < kTapsPerPhase; ++j)
+            y += phase[static_cast<size_t>(j)] * window[kTapsPerPhase - 1 - j];
+
+        peak = juce::jmax(peak, std::abs(y));
+    }
+
+    return peak;
+}
+
+void LoudnessMeter::finishSubBlock(SideState& side, PublishedReading& reading)
+{
+    const double power = side.subBlockSum / subBlockLength;
+    side.subBlockSum = 0.0;
+
+    side.subBlocks[static_cast<size_t>(side.nextSubBlock)] = power;
+    side.nextSubBlock = (side.nextSubBlock + 1) % kShortTermBlocks;
+    side.numSubBlocks = juce::jmin(side.numSubBlocks + 1, kShortTermBlocks);
+
+    const auto meanOfLast = [&side](int count) {
+        double sum = 0.0;
+        for (int i = 1; i <= count; ++i)
+            sum += side.subBlocks[static_cast<size_t>((side.nextSubBlock - i + kShortTermBlocks) % kShortTermBlocks)];
+        return sum / count;
+    };
+
+    if (side.numSubBlocks >= kMomentaryBlocks)
+    {
+        // Every momentary window is also a gating block for the integrated loudness
+        const double momentaryPower = meanOfLast(kMomentaryBlocks);
+        const float momentary = toLufs(momentaryPower);
+        reading.momentary.store(momentary, std::memory_order_relaxed);
+
+        if (momentary >= kAbsoluteGate)
+        {
+            const auto bin = static_cast<size_t>(juce::jlimit(0, kHistogramBins - 1,
+                                                              static_cast<int>((momentary - kAbsoluteGate) * 10.0f)));
+            side.gatedEnergy[bin] += momentaryPower;
+            ++side.gatedCount[bin];
+        }
+    }
+
+    if (side.numSubBlocks >= kShortTermBlocks)
+        reading.shortTerm.store(toLufs(meanOfLast(kShortTermBlocks)), std::memory_order_relaxed);
+
+    reading.integrated.store(getIntegrated(side), std::memory_order_relaxed);
+
+    double peak = 0.0;
+    for (const auto& channel : side.channels)
+        peak = juce::jmax(peak, channel.peak);
+
+    reading.truePeak.store(juce::Decibels::gainToDecibels(static_cast<float>(peak), kFloorDb), std::memory_order_relaxed);
+}
+
+float LoudnessMeter::getIntegrated(const SideState& side) noexcept
+{
+    // Stage 1: everything above the absolute gate sets the relative gate
+    double energy = 0.0;
+    juce::uint64 count = 0;
+    for (int i = 0; i < kHistogramBins; ++i)
+    {
+        energy += side.gatedEnergy[static_cast<size_t>(i)];
+        count += side.gatedCount[static_cast<size_t>(i)];
+    }
+
+    if (count == 0)
+        return kFloorDb;
+
+    // Stage 2: mean of the blocks at or above it (to the nearest 0.1 LU bin)
+    const float relativeGate = toLufs(energy / static_cast<double>(count)) + kRelativeGate;
+    const int firstBin = juce::jlimit(0, kHistogramBins, static_cast<int>(std::ceil((relativeGate - kAbsoluteGate) * 10.0f)));
+
+    energy = 0.0;
+    count = 0;
+    for (int i = firstBin; i < kHistogramBins; ++i)
+    {
+        energy += side.gatedEnergy[static_cast<size_t>(i)];
+        count += side.gatedCount[static_cast<size_t>(i)];
+    }
+
+    return count > 0 ? toLufs(energy / static_cast<double>(count)) : kFloorDb;
+}
+
+void LoudnessMeter::clearMeasurements()
+{
+    for (size_t s = 0; s < sides.size(); ++s)
+    {
+        auto& side = sides[s];
+        side.gatedEnergy.fill(0.0);
+        side.gatedCount.fill(0);
+
+        for (auto& channel : side.channels)
+            channel.peak = 0.0;
+
+        published[s].integrated.store(kFloorDb, std::memory_order_relaxed);
+        published[s].truePeak.store(kFloorDb, std::memory_order_relaxed);
+    }
+}
+
+// =============================================================================
+// READINGS
+// =============================================================================
+
+LoudnessMeter::Reading LoudnessMeter::getReading(Side side) const noexcept
+{
+    const auto& source = published[static_cast<size_t>(side)];
+
+    Reading reading;
+    reading.momentary = source.momentary.load(std::memory_order_relaxed);
+    reading.shortTerm = source.shortTerm.load(std::memory_order_relaxed);
+    reading.integrated = source.integrated.load(std::memory_order_relaxed);
+    reading.truePeak = source.truePeak.load(std::memory_order_relaxed);
+    return reading;
+}
+
+juce::var LoudnessMeter::toVar() const
+{
+    const auto toObject = [](const Reading& reading) {
+        juce::DynamicObject::Ptr object = new juce::DynamicObject();
+        object->setProperty("momentary", reading.momentary);
+        object->setProperty("shortTerm", reading.shortTerm);
+        object->setProperty("integrated", reading.integrated);
+        object->setProperty("truePeak", reading.truePeak);
+        return juce::var(object.get());
+    };
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("input", toObject(getReading(input)));
+    data->setProperty("output", toObject(getReading(output)));
+    return juce::var(data.get());
+}
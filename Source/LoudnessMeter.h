@@ -0,0 +1,149 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+    ITU-R BS.1770 loudness (momentary, short-term, integrated) and 4x
+    oversampled true peak, for the input and the output.
+
+    The audio thread only copies each block into a FIFO: the input before
+    processing, the output after. A low-priority worker drains it, runs the
+    K-weighting and oversampling filters, and publishes readings as relaxed
+    atomics that any thread can read.
+
+    Integrated loudness uses the standard two-stage gate over 400 ms blocks
+    with 75% overlap. Gated blocks are kept as energy per 0.1 LU bin, so the
+    memory doesn't grow with session length.
+*/
+class LoudnessMeter : private juce::Thread
+{
+public:
+    static constexpr float kFloorDb = -100.0f;      // reported for silence (and before a window fills)
+
+    enum Side : int { input = 0, output = 1 };
+
+    struct Reading
+    {
+        float momentary = kFloorDb;     // LUFS over 400 ms
+        float shortTerm = kFloorDb;     // LUFS over 3 s
+        float integrated = kFloorDb;    // LUFS since the last reset
+        float truePeak = kFloorDb;      // dBTP, highest since the last reset
+    };
+
+    LoudnessMeter();
+    ~LoudnessMeter() override;
+
+    /** Sizes everything and (re)starts the worker. channelWeights holds the
+        BS.1770 weight of each channel (see getChannelWeights). */
+    void prepare(double sampleRate, int maxBlockSize, std::vector<float> channelWeights);
+
+    /** BS.1770 channel weights for a layout: 0 for LFE, 1.41 for surrounds, 1 otherwise. */
+    static std::vector<float> getChannelWeights(const juce::AudioChannelSet& layout, int numChannels);
+
+    /** Stops the worker. */
+    void release();
+
+    // === Audio thread ===
+    template <typename SampleType>
+    void pushInput(const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    template <typename SampleType>
+    void pushOutput(const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    // === Any thread ===
+    /** Clears the integrated loudness and true peak; the worker does it on its next pass. */
+    void requestReset() noexcept { resetRequested.store(true, std::memory_order_release); }
+
+    Reading getReading(Side side) const noexcept;
+
+    juce::var toVar() const;
+
+private:
+    static constexpr int kPollMs = 20;
+    static constexpr int kMomentaryBlocks = 4;          // 100 ms sub-blocks per 400 ms window
+    static constexpr int kShortTermBlocks = 30;         // ... per 3 s window
+    static constexpr float kAbsoluteGate = -70.0f;
+    static constexpr float kRelativeGate = -10.0f;
+    static constexpr int kHistogramBins = 1000;         // -70 to +30 LUFS in 0.1 LU steps
+    static constexpr int kOversampling = 4;
+    static constexpr int kTapsPerPhase = 12;
+
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1 = 0.0, z2 = 0.0;
+
+        double process(double x) noexcept
+        {
+            const double y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    struct ChannelState
+    {
+        Biquad shelf;                                       // K-weighting stage 1: head shelf
+        Biquad highpass;                                    // stage 2: RLB highpass
+        std::array<double, 2 * kTapsPerPhase> history {};   // twice over, so a window never wraps
+        int historyPos = 0;
+        double peak = 0.0;
+    };
+
+    struct SideState
+    {
+        std::vector<ChannelState> channels;
+        double subBlockSum = 0.0;
+        std::array<double, kShortTermBlocks> subBlocks {};  // mean weighted power of each 100 ms
+        int numSubBlocks = 0;
+        int nextSubBlock = 0;
+        std::array<double, kHistogramBins> gatedEnergy {};
+        std::array<juce::uint32, kHistogramBins> gatedCount {};
+    };
+
+    struct alignas(64) PublishedReading
+    {
+        std::atomic<float> momentary { kFloorDb };
+        std::atomic<float> shortTerm { kFloorDb };
+        std::atomic<float> integrated { kFloorDb };
+        std::atomic<float> truePeak { kFloorDb };
+    };
+
+    void run() override;
+    void processFrames(int start, int numFrames);
+    void finishSubBlock(SideState& side, PublishedReading& reading);
+    double truePeakSample(ChannelState& channel, double x) const noexcept;
+    static float getIntegrated(const SideState& side) noexcept;
+    void clearMeasurements();
+
+    template <typename SampleType>
+    void copyIn(const juce::AudioBuffer<SampleType>& buffer, int firstChannel) noexcept;
+
+    // Set in prepare, read by both threads while running
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+    int subBlockLength = 4410;
+    std::vector<float> weights;
+    std::array<std::array<double, kTapsPerPhase>, kOversampling> phaseCoefficients {};
+
+    // Input then output channels for each frame
+    juce::AbstractFifo fifo { 1 };
+    juce::AudioBuffer<float> fifoBuffer;
+
+    // Audio thread: the region reserved for this block between pushInput and pushOutput
+    int writeStart1 = 0, writeSize1 = 0, writeStart2 = 0, writeSize2 = 0;
+    bool writePending = false;
+
+    // Worker only
+    std::array<SideState, 2> sides;
+    int subBlockPos = 0;
+
+    alignas(64) std::atomic<bool> resetRequested { false };
+    std::array<PublishedReading, 2> published;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
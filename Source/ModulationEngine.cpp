@@ -0,0 +1,150 @@
+#include "ModulationEngine.h"
+#include <random>
+
+namespace
+{
+    // LFO base rates (Hz), before the mode's wobble rate
+    constexpr float kWowRate = 0.5f;
+    constexpr float kFlutterRate = 8.0f;
+
+    // LFO phase offset between channels when modulation is unlinked
+    constexpr float kChannelPhaseSpread = 0.381966f;
+
+    // Wobble depths in samples of delay at full amount
+    constexpr float kWowDepth = 15.0f;
+    constexpr float kFlutterDepth = 5.0f;
+    constexpr float kDriftDepth = 3.0f;
+
+    // How far the hiss level breathes around its set value
+    constexpr float kHissWanderDepth = 0.35f;
+}
+
+template <typename SampleType>
+ModulationEngine<SampleType>::ModulationEngine()
+    : randomKey(SeedHash::mix(std::random_device{}()))
+{
+}
+
+template <typename SampleType>
+void ModulationEngine<SampleType>::prepare(double newSampleRate, int numChannels)
+{
+    sampleRate = newSampleRate;
+    numPreparedChannels = juce::jmax(numChannels, 1);
+
+    for (auto& lanes : values)
+        lanes.resize(numPreparedChannels);
+    for (auto& lanes : increments)
+        lanes.resize(numPreparedChannels);
+
+    updatePhaseSteps();
+    reset();
+}
+
+template <typename SampleType>
+void ModulationEngine<SampleType>::reset()
+{
+    wowPhase = 0.0f;
+    flutterPhase = 0.0f;
+    time = 0.0;
+
+    for (auto& lanes : increments)
+        lanes.fill(SampleType(0));
+
+    values[wobbleDelay].fill(SampleType(0));
+    values[filterCutoff].fill(SampleType(0));
+    values[noiseLevel].fill(SampleType(1));
+
+    samplesUntilUpdate = 0;
+}
+
+template <typename SampleType>
+void ModulationEngine<SampleType>::release()
+{
+    for (auto& lanes : values)
+        lanes.resize(0);
+    for (auto& lanes : increments)
+        lanes.resize(0);
+
+    numPreparedChannels = 0;
+}
+
+template <typename SampleType>
+void ModulationEngine<SampleType>::setTimeline(juce::uint64 key, juce::int64 samplePosition) noexcept
+{
+    randomKey = key;
+    time = static_cast<double>(samplePosition) / sampleRate;
+    samplesUntilUpdate = 0;
+    resyncPhases = true;
+}
+
+template <typename SampleType>
+void ModulationEngine<SampleType>::updatePhaseSteps() noexcept
+{
+    const auto interval = static_cast<float>(kControlInterval / sampleRate);
+    wowStep = kWowRate * rate * interval;
+    flutterStep = kFlutterRate * rate * interval;
+}
+
+template <typename SampleType>
+void ModulationEngine<SampleType>::updateTargets() noexcept
+{
+    samplesUntilUpdate = kControlInterval;
+
+    const double interval = kControlInterval / sampleRate;
+    time += interval;
+
+    // ~0.5 Hz wow and ~8 Hz flutter, scaled by the mode's wobble rate
+    if (resyncPhases)
+    {
+        const auto phaseAt = [this](double hz) { const double p = hz * rate * time; return static_cast<float>(p - std::floor(p)); };
+        wowPhase = phaseAt(kWowRate);
+        flutterPhase = phaseAt(kFlutterRate);
+        resyncPhases = false;
+    }
+    else
+    {
+        wowPhase += wowStep;
+        wowPhase -= std::floor(wowPhase);
+        flutterPhase += flutterStep;
+        flutterPhase -= std::floor(flutterPhase);
+    }
+
+    const int numSources = linked ? 1 : numPreparedChannels;
+    const float invInterval = 1.0f / static_cast<float>(kControlInterval);
+
+    for (int ch = 0; ch < numPreparedChannels; ++ch)
+    {
+        float target[numDestinations];
+
+        if (ch < numSources)
+        {
+            float random[numRandomSources];
+            for (int s = 0; s < numRandomSources; ++s)
+                random[s] = valueNoise(randomKey + static_cast<juce::uint64>(ch * numRandomSources + s) * 0x632be59bd9b4e019ull,
+                                       time, kRandomRates[s]);
+
+            const float offset = static_cast<float>(ch) * kChannelPhaseSpread;
+            const float wow = std::sin(juce::MathConstants<float>::twoPi * (wowPhase + offset));
+            const float flutter = std::sin(juce::MathConstants<float>::twoPi * (flutterPhase + offset));
+
+            // Flutter is part periodic (capstan) and part irregular (tape path)
+            target[wobbleDelay] = wow * kWowDepth
+                                + (0.6f * flutter + 0.4f * random[flutterJitter]) * kFlutterDepth
+                                + random[drift] * kDriftDepth;
+            target[filterCutoff] = random[filterWander];
+            target[noiseLevel] = 1.0f + random[hissWander] * kHissWanderDepth;
+        }
+        else
+        {
+            // Linked: follow channel 0's target (its increments are already updated)
+            for (int d = 0; d < numDestinations; ++d)
+                target[d] = static_cast<float>(values[d][0] + increments[d][0] * static_cast<SampleType>(kControlInterval));
+        }
+
+        for (int d = 0; d < numDestinations; ++d)
+            increments[d][ch] = (static_cast<SampleType>(target[d]) - values[d][ch]) * static_cast<SampleType>(invInterval);
+    }
+}
+
+template class ModulationEngine<float>;
+template class ModulationEngine<double>;
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "ChannelLanes.h"
+#include "SeedHash.h"
+#include <array>
+#include <vector>
+
+/**
+    Control-rate modulation for the tape/vinyl transport: wow and flutter LFOs
+    plus band-limited random sources (drift, flutter jitter, filter wander,
+    hiss breathing).
+
+    Sources are evaluated every kControlInterval samples and each destination
+    ramps linearly towards the new value in between, so the per-sample cost is
+    one add per channel group. Destinations are per channel; when linked, every
+    channel follows channel 0, otherwise each channel has its own random sources
+    and a fixed LFO phase offset.
+
+    The random sources are value noise over the engine's running time, hashed
+    from a key rather than drawn from a generator, so setTimeline() can place
+    the engine at any position (used to split offline renders into chunks).
+*/
+template <typename SampleType>
+class ModulationEngine
+{
+public:
+    enum Destination
+    {
+        wobbleDelay,    // delay offset in samples at full wobble
+        filterCutoff,   // -1..1 cutoff wander
+        noiseLevel,     // hiss gain around 1
+        numDestinations
+    };
+
+    static constexpr int kControlInterval = 32;
+
+    ModulationEngine();
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+    void release();
+
+    /** Per-block settings: LFO rate multiplier (the mode's wobble rate) and channel linking. */
+    void setBlockSettings(float rateMultiplier, bool linkChannels) noexcept
+    {
+        if (rateMultiplier != rate)
+        {
+            rate = rateMultiplier;
+            updatePhaseSteps();
+        }
+
+        linked = linkChannels;
+    }
+
+    /** Offline rendering: ties the random sources to a fixed key and jumps to an
+        absolute sample position. LFO phases are recomputed from that position. */
+    void setTimeline(juce::uint64 key, juce::int64 samplePosition) noexcept;
+
+    /** Moves every destination on by one sample; call once at the top of each sample. */
+    void advance() noexcept
+    {
+        if (--samplesUntilUpdate <= 0)
+            updateTargets();
+
+        for (int d = 0; d < numDestinations; ++d)
+            for (int g = 0; g < values[d].getNumGroups(); ++g)
+                values[d].group(g) += increments[d].group(g);
+    }
+
+    /** Adds the destination lanes to the owner's list for packing in a ChannelLaneBlock. */
+    void collectLanes(std::vector<ChannelLanes<SampleType>*>& lanes)
+    {
+        for (int d = 0; d < numDestinations; ++d)
+            lanes.insert(lanes.end(), { &values[d], &increments[d] });
+    }
+
+    ChannelLanes<SampleType>& get(Destination destination) noexcept { return values[destination]; }
+    SampleType get(Destination destination, int channel) const noexcept { return values[destination][channel]; }
+
+    /** Wow LFO phase (0-1), for the visualizer. */
+    float getWowPhase() const noexcept { return wowPhase; }
+
+private:
+    // Random value gliding between hashed points 1/rate seconds apart (smoothstep),
+    // giving noise band-limited to roughly that rate
+    static float valueNoise(juce::uint64 key, double time, float rateHz) noexcept
+    {
+        const double x = time * static_cast<double>(rateHz);
+        const double cell = std::floor(x);
+        const auto index = static_cast<juce::int64>(cell);
+        const auto t = static_cast<float>(x - cell);
+
+        const float from = SeedHash::toBipolar(SeedHash::combine(key, index));
+        const float to = SeedHash::toBipolar(SeedHash::combine(key, index + 1));
+        return from + (to - from) * (t * t * (3.0f - 2.0f * t));
+    }
+
+    enum RandomSource { drift, flutterJitter, filterWander, hissWander, numRandomSources };
+    static constexpr float kRandomRates[numRandomSources] = { 0.3f, 6.0f, 0.15f, 1.5f };  // Hz
+
+    void updateTargets() noexcept;
+    void updatePhaseSteps() noexcept;
+
+    double sampleRate = 44100.0;
+    int numPreparedChannels = 0;
+    int samplesUntilUpdate = 0;
+
+    float rate = 1.0f;
+    bool linked = true;
+
+    // LFO phase advance per control interval at the current rate
+    float wowStep = 0.0f;
+    float flutterStep = 0.0f;
+
+    float wowPhase = 0.0f;
+    float flutterPhase = 0.0f;
+    bool resyncPhases = false;
+
+    double time = 0.0;              // seconds since prepare (or the timeline position)
+    juce::uint64 randomKey = 0;
+
+    std::array<ChannelLanes<SampleType>, numDestinations> values;
+    std::array<ChannelLanes<SampleType>, numDestinations> increments;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationEngine)
+};
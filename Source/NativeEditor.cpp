@@ -0,0 +1,386 @@
+#include "NativeEditor.h"
+#include "ParameterIDs.h"
+
+namespace
+{
+    const juce::Colour backgroundColour { 0xff0a0a0c };
+    const juce::Colour panelColour { 0xff141418 };
+    const juce::Colour dimTextColour { 0x80ffffff };
+
+    // Same accents as the web UI's mode selector
+    const juce::Colour modeColours[] = {
+        juce::Colour(0xffff6b35),   // Cassette
+        juce::Colour(0xff8b5cf6),   // Vinyl
+        juce::Colour(0xff06b6d4),   // VHS
+        juce::Colour(0xff22c55e)    // Radio
+    };
+
+    constexpr int kMargin = 10;
+    constexpr int kHeaderHeight = 44;
+    constexpr int kSectionTitleHeight = 20;
+    constexpr int kCaptionHeight = 14;
+    constexpr int kRowHeight = 124;
+}
+
+OxideNativeEditor::OxideNativeEditor(OxideAudioProcessor& p)
+    : AudioProcessorEditor(&p), processorRef(p),
+      lookAndFeel(juce::LookAndFeel_V4::getMidnightColourScheme())
+{
+    OXIDE_TRACE_ZONE("Editor construction");
+    lookAndFeel.setColour(juce::ResizableWindow::backgroundColourId, backgroundColour);
+    setLookAndFeel(&lookAndFeel);
+
+    // Mode sits in the header; everything else is grouped like the web UI
+    addControl(ParameterIDs::mode)->caption->setVisible(false);
+
+    addSection("DEGRADATION", { ParameterIDs::bitcrush, ParameterIDs::downsample, ParameterIDs::noise,
+                                ParameterIDs::crackle, ParameterIDs::crushMode });
+    addSection("CHARACTER", { ParameterIDs::wobble, ParameterIDs::dropout, ParameterIDs::saturation,
+                              ParameterIDs::age, ParameterIDs::satEngine });
+    addSection("FILTER", { ParameterIDs::filterCutoff, ParameterIDs::filterRes, ParameterIDs::filterDrive });
+    addSection("OUTPUT", { ParameterIDs::mix, ParameterIDs::output, ParameterIDs::bypass,
+                           ParameterIDs::linkChannels });
+    addSection("MORPH", { ParameterIDs::morph, ParameterIDs::morphOn });
+    addSection("ENVELOPE", { ParameterIDs::envAttack, ParameterIDs::envRelease, ParameterIDs::envToAge,
+                             ParameterIDs::envToNoise, ParameterIDs::envToSaturation, ParameterIDs::envToFilter,
+                             ParameterIDs::envMode });
+
+    storeA.onClick = [this] { processorRef.storeMorphSnapshot(0); };
+    storeB.onClick = [this] { processorRef.storeMorphSnapshot(1); };
+    addAndMakeVisible(storeA);
+    addAndMakeVisible(storeB);
+
+    presetBox.setTextWhenNothingSelected("Preset");
+    presetBox.onChange = [this] {
+        const int index = presetBox.getSelectedId() - 1;
+        if (index >= 0 && index != processorRef.getCurrentProgram())
+            processorRef.setCurrentProgram(index);
+    };
+    addAndMakeVisible(presetBox);
+    processorRef.reloadUserPresets();
+    updatePresetList();
+
+    // Hosts can't swap an open editor's content, so the choice applies on reopen
+    switchToWeb.setClickingTogglesState(true);
+    switchToWeb.onClick = [this] {
+        const bool web = switchToWeb.getToggleState();
+        processorRef.setUsesNativeEditor(! web);
+        switchToWeb.setButtonText(web ? "Reopen for Web UI" : "Web UI");
+    };
+    addAndMakeVisible(switchToWeb);
+
+    addAndMakeVisible(meter);
+
+    setAccentColour(processorRef.getCurrentMode());
+    processorRef.addListener(this);
+
+    setSize(820, kHeaderHeight + 2 * kRowHeight + 3 * kMargin);
+    setResizable(false, false);
+
+    updateMeterTimer();
+}
+
+OxideNativeEditor::~OxideNativeEditor()
+{
+    processorRef.removeListener(this);
+    stopTimer();
+    setLookAndFeel(nullptr);
+}
+
+OxideNativeEditor::Control* OxideNativeEditor::addControl(const char* parameterID)
+{
+    auto& apvts = processorRef.getAPVTS();
+    auto* parameter = apvts.getParameter(parameterID);
+    jassert(parameter != nullptr);
+
+    auto control = std::make_unique<Control>();
+
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(parameter))
+    {
+        auto box = std::make_unique<juce::ComboBox>();
+        box->addItemList(choice->choices, 1);
+        control->comboAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, parameterID, *box);
+        control->component = std::move(box);
+    }
+    else if (dynamic_cast<juce::AudioParameterBool*>(parameter) != nullptr)
+    {
+        auto button = std::make_unique<juce::ToggleButton>();
+        control->buttonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, parameterID, *button);
+        control->component = std::move(button);
+    }
+    else
+    {
+        auto slider = std::make_unique<juce::Slider>(juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow);
+        slider->setTextBoxStyle(juce::Slider::TextBoxBelow, false, 52, 14);
+        control->sliderAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, parameterID, *slider);
+        control->component = std::move(slider);
+    }
+
+    control->caption = std::make_unique<juce::Label>(juce::String(), parameter->getName(16).toUpperCase());
+    control->caption->setJustificationType(juce::Justification::centred);
+    control->caption->setFont(juce::FontOptions(10.0f));
+    control->caption->setColour(juce::Label::textColourId, dimTextColour);
+
+    addAndMakeVisible(*control->component);
+    addAndMakeVisible(*control->caption);
+
+    controls.push_back(std::move(control));
+    return controls.back().get();
+}
+
+void OxideNativeEditor::addSection(const juce::String& title, std::initializer_list<const char*> parameterIDs)
+{
+    Section section;
+    section.title = title;
+
+    for (auto* id : parameterIDs)
+        section.controls.push_back(addControl(id));
+
+    sections.push_back(std::move(section));
+}
+
+void OxideNativeEditor::updatePresetList()
+{
+    const auto presets = processorRef.getPresetBank().getPresets();
+
+    presetBox.clear(juce::dontSendNotification);
+
+    juce::String category;
+    for (int i = 0; i < static_cast<int>(presets->size()); ++i)
+    {
+        const auto& preset = (*presets)[static_cast<size_t>(i)];
+        if (preset.category != category)
+        {
+            category = preset.category;
+            presetBox.addSectionHeading(category);
+        }
+        presetBox.addItem(preset.name, i + 1);
+    }
+
+    presetBox.setSelectedId(processorRef.getCurrentProgram() + 1, juce::dontSendNotification);
+}
+
+void OxideNativeEditor::audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details)
+{
+    if (! details.programChanged)
+        return;
+
+    // Hosts may change program from any thread
+    juce::MessageManager::callAsync([safeThis = juce::Component::SafePointer<OxideNativeEditor>(this)] {
+        if (safeThis != nullptr)
+            safeThis->updatePresetList();
+    });
+}
+
+void OxideNativeEditor::setAccentColour(int mode)
+{
+    accentMode = mode;
+    const auto accent = modeColours[juce::jlimit(0, 3, mode)];
+
+    lookAndFeel.setColour(juce::Slider::rotarySliderFillColourId, accent);
+    lookAndFeel.setColour(juce::Slider::thumbColourId, accent);
+    lookAndFeel.setColour(juce::ToggleButton::tickColourId, accent);
+    lookAndFeel.setColour(juce::TextButton::buttonOnColourId, accent.withAlpha(0.6f));
+    meter.setBarColour(accent);
+
+    // Rare (mode changes only), so a full repaint is fine
+    sendLookAndFeelChange();
+    repaint();
+}
+
+// =============================================================================
+// METER
+// =============================================================================
+
+bool OxideNativeEditor::LevelMeter::setLevels(float newRms, float newPeak, bool newBypassed)
+{
+    constexpr float epsilon = 1.0e-4f;
+
+    if (std::abs(newRms - rms) <= epsilon && std::abs(newPeak - peak) <= epsilon && newBypassed == bypassed)
+        return false;
+
+    rms = newRms;
+    peak = newPeak;
+    bypassed = newBypassed;
+    repaint();
+    return true;
+}
+
+void OxideNativeEditor::LevelMeter::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    g.setColour(juce::Colours::white.withAlpha(0.06f));
+    g.fillRoundedRectangle(bounds, 2.0f);
+
+    // -60..0 dBFS across the width
+    const auto toWidth = [&bounds](float level) {
+        const float db = juce::Decibels::gainToDecibels(level, -60.0f);
+        return bounds.getWidth() * juce::jlimit(0.0f, 1.0f, (db + 60.0f) / 60.0f);
+    };
+
+    const auto barColour = bypassed ? juce::Colours::grey : colour;
+    g.setColour(barColour.withAlpha(0.8f));
+    g.fillRoundedRectangle(bounds.withWidth(toWidth(rms)), 2.0f);
+
+    g.setColour(barColour.brighter(0.4f));
+    g.fillRect(bounds.getX() + juce::jmax(0.0f, toWidth(peak) - 2.0f), bounds.getY(), 2.0f, bounds.getHeight());
+}
+
+void OxideNativeEditor::updateMeterTimer()
+{
+    // Hidden editors do no periodic work at all
+    if (! isShowing())
+    {
+        stopTimer();
+        stoppedWhileHidden = true;
+        return;
+    }
+
+    stoppedWhileHidden = false;
+    restartMeterTimer();
+}
+
+void OxideNativeEditor::restartMeterTimer()
+{
+    unchangedPolls = 0;
+    idle = false;
+    startTimerHz(processorRef.getVisualizerFrameRate());
+}
+
+void OxideNativeEditor::timerCallback()
+{
+    OXIDE_TRACE_ZONE("Native editor frame");
+
+    // Hidden without a visibility callback: stop until we're painted again
+    if (! isShowing())
+    {
+        updateMeterTimer();
+        return;
+    }
+
+    if (processorRef.getCurrentMode() != accentMode)
+        setAccentColour(processorRef.getCurrentMode());
+
+    if (meter.setLevels(processorRef.getCurrentRMS(), processorRef.getCurrentPeak(), processorRef.isBypassed()))
+    {
+        if (idle)
+            restartMeterTimer();
+        else
+            unchangedPolls = 0;
+        return;
+    }
+
+    // Nothing moving: poll slowly until it does
+    const int frameRate = processorRef.getVisualizerFrameRate();
+    if (! idle && ++unchangedPolls >= juce::roundToInt(static_cast<float>(frameRate) * kIdleBackoffSeconds))
+    {
+        idle = true;
+        startTimerHz(kIdlePollHz);
+    }
+}
+
+// =============================================================================
+// LAYOUT
+// =============================================================================
+
+void OxideNativeEditor::paint(juce::Graphics& g)
+{
+    // Painted, so on screen again: the meter resumes even if nothing told us
+    if (std::exchange(stoppedWhileHidden, false))
+        restartMeterTimer();
+
+    g.fillAll(backgroundColour);
+
+    const auto accent = modeColours[juce::jlimit(0, 3, accentMode)];
+
+    g.setColour(accent);
+    g.setFont(juce::FontOptions(20.0f, juce::Font::bold));
+    g.drawText("OXIDE", kMargin, 0, 100, kHeaderHeight, juce::Justification::centredLeft);
+
+    for (const auto& section : sections)
+    {
+        g.setColour(panelColour);
+        g.fillRoundedRectangle(section.bounds.toFloat(), 6.0f);
+
+        g.setColour(dimTextColour);
+        g.setFont(juce::FontOptions(10.0f, juce::Font::bold));
+        g.drawText(section.title, section.bounds.withHeight(kSectionTitleHeight).reduced(8, 0),
+                   juce::Justification::centredLeft);
+    }
+}
+
+void OxideNativeEditor::resized()
+{
+    auto area = getLocalBounds().reduced(kMargin, 0);
+
+    // Header: title | mode | preset ... meter | web switch
+    auto header = area.removeFromTop(kHeaderHeight).reduced(0, 10);
+    header.removeFromLeft(100);
+
+    controls.front()->component->setBounds(header.removeFromLeft(120));
+    header.removeFromLeft(8);
+    presetBox.setBounds(header.removeFromLeft(200));
+
+    switchToWeb.setBounds(header.removeFromRight(130));
+    header.removeFromRight(12);
+    meter.setBounds(header.removeFromRight(160).withSizeKeepingCentre(160, 8));
+
+    // Two rows of sections, widths proportional to their number of controls
+    // (the morph section has an extra cell for its snapshot buttons)
+    const auto getNumCells = [](const Section& section) {
+        return static_cast<int>(section.controls.size()) + (section.title == "MORPH" ? 1 : 0);
+    };
+
+    const auto layoutRow = [this, &getNumCells](juce::Rectangle<int> row, size_t first, size_t last) {
+        int cells = 0;
+        for (size_t i = first; i < last; ++i)
+            cells += getNumCells(sections[i]);
+
+        const int cellWidth = (row.getWidth() - static_cast<int>(last - first - 1) * kMargin) / cells;
+
+        for (size_t i = first; i < last; ++i)
+        {
+            auto& section = sections[i];
+            section.bounds = row.removeFromLeft(i + 1 == last ? row.getWidth() : getNumCells(section) * cellWidth);
+            row.removeFromLeft(kMargin);
+
+            auto content = section.bounds.reduced(4, 0);
+            content.removeFromTop(kSectionTitleHeight);
+            content.removeFromBottom(6);
+
+            for (auto* control : section.controls)
+            {
+                auto cell = content.removeFromLeft(cellWidth);
+                control->caption->setBounds(cell.removeFromTop(kCaptionHeight));
+
+                if (dynamic_cast<juce::Slider*>(control->component.get()) != nullptr)
+                    control->component->setBounds(cell.reduced(2));
+                else
+                    control->component->setBounds(cell.withSizeKeepingCentre(cell.getWidth() - 6, 24));
+            }
+
+            // Morph snapshot buttons take the section's last cell
+            if (section.title == "MORPH")
+            {
+                auto buttons = content.withSizeKeepingCentre(content.getWidth() - 6, 56);
+                storeA.setBounds(buttons.removeFromTop(24));
+                storeB.setBounds(buttons.removeFromBottom(24));
+            }
+        }
+    };
+
+    area.removeFromTop(kMargin / 2);
+    layoutRow(area.removeFromTop(kRowHeight), 0, 3);
+    area.removeFromTop(kMargin);
+    layoutRow(area.removeFromTop(kRowHeight), 3, sections.size());
+}
+
+void OxideNativeEditor::visibilityChanged()
+{
+    updateMeterTimer();
+}
+
+void OxideNativeEditor::parentHierarchyChanged()
+{
+    updateMeterTimer();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "PluginProcessor.h"
+#include <juce_gui_basics/juce_gui_basics.h>
+
+/**
+    Lightweight fallback editor built from plain JUCE components: no WebView, no
+    JS runtime, no canvas effects. Every parameter in ParameterIDs gets a control
+    attached straight to the APVTS, grouped like the web UI.
+
+    The only periodic work is the level meter: polled at the visualizer frame
+    budget while the signal moves, backed off to kIdlePollHz once it settles,
+    and stopped while the editor isn't showing. A restored or uncovered host
+    window doesn't always tell us, so the first paint after being hidden
+    restarts it. Repaints are limited to the meter's bounds.
+*/
+class OxideNativeEditor : public juce::AudioProcessorEditor,
+                          private juce::AudioProcessorListener,
+                          private juce::Timer
+{
+public:
+    explicit OxideNativeEditor(OxideAudioProcessor&);
+    ~OxideNativeEditor() override;
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+
+private:
+    // One parameter's control, its caption and attachment
+    struct Control
+    {
+        std::unique_ptr<juce::Component> component;
+        std::unique_ptr<juce::Label> caption;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sliderAttachment;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> comboAttachment;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> buttonAttachment;
+    };
+
+    struct Section
+    {
+        juce::String title;
+        std::vector<Control*> controls;
+        juce::Rectangle<int> bounds;
+    };
+
+    // Input level (RMS bar with a peak line); repaints only when it changes
+    class LevelMeter : public juce::Component
+    {
+    public:
+        bool setLevels(float newRms, float newPeak, bool newBypassed);
+        void setBarColour(juce::Colour newColour) { colour = newColour; repaint(); }
+        void paint(juce::Graphics&) override;
+    private:
+        float rms = 0.0f;
+        float peak = 0.0f;
+        bool bypassed = false;
+        juce::Colour colour;
+    };
+
+    Control* addControl(const char* parameterID);
+    void addSection(const juce::String& title, std::initializer_list<const char*> parameterIDs);
+    void updatePresetList();
+    void updateMeterTimer();
+    void restartMeterTimer();
+    void setAccentColour(int mode);
+
+    void timerCallback() override;
+
+    // AudioProcessorListener: keep the preset box in step with the host
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override {}
+    void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details) override;
+
+    OxideAudioProcessor& processorRef;
+    juce::LookAndFeel_V4 lookAndFeel;
+
+    std::vector<std::unique_ptr<Control>> controls;
+    std::vector<Section> sections;
+
+    juce::ComboBox presetBox;
+    juce::TextButton storeA { "Store A" };
+    juce::TextButton storeB { "Store B" };
+    juce::TextButton switchToWeb { "Web UI" };
+    LevelMeter meter;
+
+    int accentMode = -1;
+    int unchangedPolls = 0;
+    bool idle = false;
+    bool stoppedWhileHidden = false;
+
+    static constexpr int kIdlePollHz = 4;
+    static constexpr float kIdleBackoffSeconds = 0.5f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OxideNativeEditor)
+};
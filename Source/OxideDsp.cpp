@@ -0,0 +1,1015 @@
+#include "OxideDsp.h"
+#include "Trace.h"
+
+template <typename SampleType>
+OxideDsp<SampleType>::OxideDsp()
+    : noiseGen(std::random_device{}()),
+      eventGen(std::random_device{}())
+{
+}
+
+template <typename SampleType>
+const typename OxideDsp<SampleType>::ModeChar& OxideDsp<SampleType>::getModeChar(int mode) noexcept
+{
+    static const ModeChar modeChars[4] = {
+        // Cassette: warm, wobbly, hissy
+        { 0.6f, 1.0f, 1.0f, 0.6f, 40.0f, 14000.0f, 1.0f, 300.0f, 2.0f },
+        // Vinyl: crackly, warm, slight wobble
+        { 0.4f, 0.3f, 0.5f, 0.4f, 30.0f, 16000.0f, 0.5f, 3000.0f, 1.5f },
+        // VHS: heavy wobble, muffled, artifacts
+        { 0.8f, 2.0f, 0.7f, 0.7f, 60.0f, 10000.0f, 1.5f, 600.0f, 2.0f },
+        // Radio: bandpass, noise, compression
+        { 1.0f, 0.1f, 2.0f, 0.8f, 300.0f, 5000.0f, 2.0f, 1200.0f, 1.5f },
+    };
+
+    return modeChars[juce::jlimit(0, 3, mode)];
+}
+
+template <typename SampleType>
+typename OxideDsp<SampleType>::BitcrushCoefficients OxideDsp<SampleType>::makeBitcrush(float amount, bool clean) noexcept
+{
+    // Map 0-1 to 24-bit down to 2-bit (age scales the amount up to 3, which stays at 2-bit)
+    const float bits = juce::jlimit(2.0f, 24.0f, 24.0f - amount * 22.0f);
+
+    BitcrushCoefficients c;
+    c.levels = static_cast<SampleType>(std::pow(2.0f, clean ? juce::jmin(bits, kMaxCleanBits) : bits));
+    c.step = SampleType(1) / c.levels;
+    c.noise = ! clean && bits < 8.0f ? 0.002f * (8.0f - bits) : 0.0f;
+    return c;
+}
+
+template <typename SampleType>
+typename OxideDsp<SampleType>::DownsampleCoefficients OxideDsp<SampleType>::makeDownsample(float amount) noexcept
+{
+    // Map 0-1 to factor 1-64
+    DownsampleCoefficients c;
+    c.factor = 1.0f + amount * 63.0f;
+    c.prefilter = static_cast<SampleType>(std::exp(-juce::MathConstants<float>::twoPi * 0.45f / c.factor));
+    return c;
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::invalidateDerived() noexcept
+{
+    bitcrushCoefficients.invalidate();
+    downsampleCoefficients.invalidate();
+    saturationDrive.invalidate();
+    modeCharacter.invalidate();
+    crackleRate.invalidate();
+    dropoutRate.invalidate();
+    filterDrive.invalidate();
+    lowpassResonance.invalidate();
+    lowpassCutoff.invalidate();
+    highpassCutoff.invalidate();
+    outputGain.invalidate();
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::prepare(double sampleRate, int maxBlockSize, int numChannels, const ParameterSnapshot& initial)
+{
+    currentSampleRate = sampleRate;
+    preparedBlockSize = juce::jmax(1, maxBlockSize);
+
+    // Shared with every other instance at this rate (built here on first use, never on the audio thread)
+    if (tables == nullptr || tables->getSampleRate() != sampleRate)
+        tables = SharedTables<SampleType>::getFor(sampleRate);
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(maxBlockSize * 2);
+    spec.numChannels = static_cast<juce::uint32>(numChannels);
+
+    // Prepare filters
+    lowpassFilter.prepare(spec);
+    lowpassFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+
+    highpassFilter.prepare(spec);
+    highpassFilter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
+
+    bandpassFilter.prepare(spec);
+    bandpassFilter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+
+    tapeHeadFilter.prepare(spec);
+    tapeHeadFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    tapeHeadFilter.setCutoffFrequency(SampleType(80));  // Tape head bump
+
+    // Per-channel state, sized for whatever layout the host gave us
+    numPreparedChannels = juce::jmax(numChannels, 1);
+
+    hysteresis.prepare(sampleRate, numPreparedChannels);
+
+    ditherSeeds.resize(static_cast<size_t>(numPreparedChannels));
+    for (size_t ch = 0; ch < ditherSeeds.size(); ++ch)
+        ditherSeeds[ch] = 0x9e3779b9u * static_cast<juce::uint32>(ch + 1);
+
+    crackleVoices.assign(static_cast<size_t>(numPreparedChannels * kMaxCrackleVoices), CrackleVoice {});
+    crackleHazard.resize(static_cast<size_t>(numPreparedChannels));
+    for (auto& hazard : crackleHazard)
+        hazard = drawCrackleHazard();
+
+    delayLines.assign(static_cast<size_t>(numPreparedChannels) * kMaxDelaySize, SampleType(0));
+    delayWritePos = 0;
+    dryDelayLines.assign(static_cast<size_t>(numPreparedChannels) * kMaxDelaySize, SampleType(0));
+    dryDelayPos = 0;
+
+    dryBuffer.setSize(numPreparedChannels, preparedBlockSize, false, false, true);
+
+    dropoutEvents.assign(static_cast<size_t>(numPreparedChannels), DropoutEvent {});
+    for (auto& event : dropoutEvents)
+        event.hazard = drawCrackleHazard();
+    dropoutGains.setSize(numPreparedChannels, preparedBlockSize, false, false, true);
+
+    modulation.prepare(sampleRate, numPreparedChannels);
+
+    // Every lane the sample loop touches (ours, the hysteresis model's and the
+    // modulation engine's) goes into one cache-line-aligned block
+    std::vector<ChannelLanes<SampleType>*> hotLanes { &frame, &noiseLanes, &lastSample, &sampleHoldCounter, &pinkState,
+                                                     &quantError, &holdPrefilter1, &holdPrefilter2, &holdResidual,
+                                                     &hysteresisLanes, &dropoutLanes, &dcState };
+    hysteresis.collectLanes(hotLanes);
+    modulation.collectLanes(hotLanes);
+    laneState.allocate(std::move(hotLanes), numPreparedChannels);
+
+    cutoffModulation.assign(static_cast<size_t>(preparedBlockSize), 0.0f);
+    envelopeTrace.assign(static_cast<size_t>(preparedBlockSize / ModulationEngine<SampleType>::kControlInterval + 2), 0.0f);
+    envelopeState = 0.0f;
+
+    // Parameter smoothing
+    const double smoothTime = 0.02;
+    bitcrushSmoothed.reset(sampleRate, smoothTime);
+    downsampleSmoothed.reset(sampleRate, smoothTime);
+    noiseSmoothed.reset(sampleRate, smoothTime);
+    wobbleSmoothed.reset(sampleRate, smoothTime);
+    saturationSmoothed.reset(sampleRate, smoothTime);
+    filterCutoffSmoothed.reset(sampleRate, 0.05);
+    mixSmoothed.reset(sampleRate, smoothTime);
+    modeBlendSmoothed.reset(sampleRate, smoothTime);
+
+    // Initialize to current values
+    bitcrushSmoothed.setCurrentAndTargetValue(initial[ParameterIDs::Index::bitcrush]);
+    downsampleSmoothed.setCurrentAndTargetValue(initial[ParameterIDs::Index::downsample]);
+    noiseSmoothed.setCurrentAndTargetValue(initial[ParameterIDs::Index::noise]);
+    wobbleSmoothed.setCurrentAndTargetValue(initial[ParameterIDs::Index::wobble]);
+    saturationSmoothed.setCurrentAndTargetValue(initial[ParameterIDs::Index::saturation]);
+    filterCutoffSmoothed.setCurrentAndTargetValue(initial[ParameterIDs::Index::filterCutoff]);
+    mixSmoothed.setCurrentAndTargetValue(initial[ParameterIDs::Index::mix]);
+    modeBlendSmoothed.setCurrentAndTargetValue(0.0f);
+
+    // DC blocker coefficient
+    dcCoeff = SampleType(1) - SampleType(20) / static_cast<SampleType>(sampleRate);
+
+    // Rates are per sample and the filters were just re-prepared
+    invalidateDerived();
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::reset()
+{
+    lowpassFilter.reset();
+    highpassFilter.reset();
+    bandpassFilter.reset();
+    tapeHeadFilter.reset();
+    hysteresis.reset();
+    modulation.reset();
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::beginEpoch(juce::uint64 seed, juce::int64 samplePosition)
+{
+    const auto epochSeed = SeedHash::combine(seed, samplePosition);
+
+    noiseGen.seed(static_cast<std::mt19937::result_type>(epochSeed));
+    eventGen.seed(static_cast<std::mt19937::result_type>(epochSeed >> 32));
+
+    for (size_t ch = 0; ch < ditherSeeds.size(); ++ch)
+        ditherSeeds[ch] = static_cast<juce::uint32>(SeedHash::combine(epochSeed, static_cast<juce::int64>(ch)));
+
+    for (auto& hazard : crackleHazard)
+        hazard = drawCrackleHazard();
+    for (auto& event : dropoutEvents)
+        event.hazard = drawCrackleHazard();
+
+    // State with unbounded memory has to restart from the same place in every
+    // render, or a chunk (whose warm-up began elsewhere) never converges on the
+    // serial result: the noise shaper's error feedback restarts from zero, and
+    // the hold and the hysteresis model restart from the first sample of the epoch
+    sampleHoldCounter.fill(SampleType(0));
+    quantError.fill(SampleType(0));
+    resyncAtEpoch = true;
+    hysteresis.resync();
+
+    // The modulation key stays fixed for the whole render so its noise runs on seamlessly
+    modulation.setTimeline(seed, samplePosition);
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::release()
+{
+    numPreparedChannels = 0;
+    preparedBlockSize = 0;
+    tables.reset();
+
+    laneState.release();
+    hysteresis.release();
+    modulation.release();
+    cutoffModulation = {};
+    envelopeTrace = {};
+
+    ditherSeeds = {};
+
+    dropoutEvents = {};
+    dropoutGains.setSize(0, 0);
+
+    crackleVoices = {};
+    crackleHazard = {};
+
+    delayLines = {};
+    dryDelayLines = {};
+    dryBuffer.setSize(0, 0);
+}
+
+template <typename SampleType>
+double OxideDsp<SampleType>::getTailSeconds(double sampleRate) noexcept
+{
+    // A resonant lowpass decays with time constant 2Q / w; -60 dB takes ln(1000) of those
+    const double ringSeconds = std::log(1000.0) * 2.0 * kMaxResonance
+                             / (juce::MathConstants<double>::twoPi * kMinCutoffHz);
+
+    return (kWobbleBaseDelay + kMaxWobbleExcursion) / sampleRate + ringSeconds;
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::processBypassed(juce::AudioBuffer<SampleType>& buffer)
+{
+    delayDry(buffer, buffer.getNumSamples());
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::delayDry(juce::AudioBuffer<SampleType>& signal, int numSamples) noexcept
+{
+    constexpr int mask = kMaxDelaySize - 1;
+    const int numChannels = juce::jmin(signal.getNumChannels(), numPreparedChannels);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* line = dryDelayLines.data() + static_cast<size_t>(ch) * kMaxDelaySize;
+        auto* data = signal.getWritePointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int writePos = (dryDelayPos + i) & mask;
+            line[writePos] = data[i];
+            data[i] = line[(writePos - kWobbleBaseDelay) & mask];
+        }
+    }
+
+    dryDelayPos = (dryDelayPos + numSamples) & mask;
+}
+
+template <typename SampleType>
+typename OxideDsp<SampleType>::BlockMeters OxideDsp<SampleType>::process(juce::AudioBuffer<SampleType>& buffer,
+                                                                           const BlockSettings& settings)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= preparedBlockSize)
+        return processSubBlock(buffer, settings);
+
+    // Oversized host block: run it through in prepared-size pieces that alias the
+    // caller's channels (no copy, no allocation); the meters are the last piece's
+    const int numChannels = buffer.getNumChannels();
+    const int subBlockSize = juce::jmax(1, preparedBlockSize);
+    BlockMeters meters;
+
+    for (int start = 0; start < numSamples; start += subBlockSize)
+    {
+        juce::AudioBuffer<SampleType> piece(buffer.getArrayOfWritePointers(), numChannels, start,
+                                            juce::jmin(subBlockSize, numSamples - start));
+        meters = processSubBlock(piece, settings);
+    }
+
+    return meters;
+}
+
+template <typename SampleType>
+typename OxideDsp<SampleType>::BlockMeters OxideDsp<SampleType>::processSubBlock(juce::AudioBuffer<SampleType>& buffer,
+                                                                                   const BlockSettings& settings)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    const float sampleRate = static_cast<float>(currentSampleRate);
+
+    const auto& params = settings.params;
+    const int modeA = settings.modeA;
+    const int modeB = settings.modeB;
+
+    const float bitcrushVal = params[ParameterIDs::Index::bitcrush];
+    const float downsampleVal = params[ParameterIDs::Index::downsample];
+    const float noiseVal = params[ParameterIDs::Index::noise];
+    const float crackleVal = params[ParameterIDs::Index::crackle];
+    const float wobbleVal = params[ParameterIDs::Index::wobble];
+    const float dropoutVal = params[ParameterIDs::Index::dropout];
+    const float saturationVal = params[ParameterIDs::Index::saturation];
+    const float ageVal = params[ParameterIDs::Index::age];
+    const float filterCutoffVal = params[ParameterIDs::Index::filterCutoff];
+    const float filterResVal = params[ParameterIDs::Index::filterRes];
+    const float filterDriveVal = params[ParameterIDs::Index::filterDrive];
+    const float mixVal = params[ParameterIDs::Index::mix];
+    const float outputVal = params[ParameterIDs::Index::output];
+
+    // Update smoothed parameters
+    bitcrushSmoothed.setTargetValue(bitcrushVal);
+    downsampleSmoothed.setTargetValue(downsampleVal);
+    noiseSmoothed.setTargetValue(noiseVal);
+    wobbleSmoothed.setTargetValue(wobbleVal);
+    saturationSmoothed.setTargetValue(saturationVal);
+    filterCutoffSmoothed.setTargetValue(filterCutoffVal);
+    mixSmoothed.setTargetValue(mixVal);
+    modeBlendSmoothed.setTargetValue(settings.modeBlend);
+
+    // Get mode characteristics (blended across the morph when the modes differ)
+    const float modeBlend = settings.modeBlend;
+    const auto& mc = modeCharacter.get([](int a, int b, float t)
+    {
+        return a == b ? getModeChar(a) : ModeChar::interpolate(getModeChar(a), getModeChar(b), t);
+    }, modeA, modeB, modeBlend);
+
+    // Dropouts and the hysteresis engine only exist on tape formats (Cassette, VHS)
+    const auto isTape = [](int m) { return m == 0 || m == 2; };
+    const float dropoutWeight = (isTape(modeA) ? 1.0f - modeBlend : 0.0f) + (isTape(modeB) ? modeBlend : 0.0f);
+
+    // Age affects all degradation
+    const auto ageMultiplier = [](float age) { return 1.0f + juce::jlimit(0.0f, 100.0f, age) / 100.0f * 2.0f; };
+    const float ageMult = ageMultiplier(ageVal);
+
+    // Envelope routing depths, in points of each target's 0-100 range at full envelope
+    const float envToAge = params[ParameterIDs::Index::envToAge];
+    const float envToNoise = params[ParameterIDs::Index::envToNoise];
+    const float envToSaturation = params[ParameterIDs::Index::envToSaturation];
+    const float envToFilter = params[ParameterIDs::Index::envToFilter];
+    const bool envelopeOn = envToAge != 0.0f || envToNoise != 0.0f || envToSaturation != 0.0f || envToFilter != 0.0f;
+
+    // Store overall degradation for visualizer
+    BlockMeters meters;
+    meters.degradation = (bitcrushVal + downsampleVal + noiseVal + wobbleVal + saturationVal) / 500.0f * ageMult;
+
+    // =========================================================================
+    // STORE DRY SIGNAL
+    // =========================================================================
+    OXIDE_TRACE_ZONE_BEGIN(dryZone, "Dry copy");
+    dryBuffer.makeCopyOf(buffer, true);
+    delayDry(dryBuffer, numSamples);
+    OXIDE_TRACE_ZONE_END(dryZone);
+
+    // =========================================================================
+    // ENVELOPE FOLLOWER
+    // =========================================================================
+    if (envelopeOn)
+        followEnvelope(buffer, numSamples, params[ParameterIDs::Index::envAttack],
+                       params[ParameterIDs::Index::envRelease], params[ParameterIDs::Index::envMode] > 0.5f);
+
+    // =========================================================================
+    // PROCESSING
+    //
+    // Sample-outer, channel-inner: each sample of every channel is gathered
+    // into SIMD lanes, so layouts up to 7.1.4 and beyond run a handful of
+    // register-wide operations per sample instead of one pass per channel.
+    // =========================================================================
+    const int numLaneChannels = std::min(numChannels, numPreparedChannels);
+    const int numGroups = frame.getNumGroups();
+    auto* const* channelData = buffer.getArrayOfWritePointers();
+
+    // LFO increments for wow/flutter
+    // Linked: every channel shares one wow/flutter curve. Unlinked: each channel
+    // gets its own random sources and an LFO phase offset, so the wobble decorrelates.
+    const bool linkChannels = params[ParameterIDs::Index::linkChannels] > 0.5f;
+    modulation.setBlockSettings(mc.wobbleRate, linkChannels);
+
+    const bool pinkNoise = mc.noiseColor < 0.5f;
+    const bool cleanCrush = params[ParameterIDs::Index::crushMode] > 0.5f;
+    const bool tapeHysteresis = params[ParameterIDs::Index::satEngine] > 0.5f && dropoutWeight > 0.0f;
+
+    // Crackle density: events per sample from the mode's density curve
+    const float crackleAmount = crackleVal / 100.0f;
+    const float cracklePerSample = crackleRate.get([sampleRate](float amount, float density, float curve, float age)
+    {
+        return amount > 0.01f ? density * std::pow(amount / 100.0f, curve) * age / sampleRate : 0.0f;
+    }, crackleVal, mc.crackleDensity, mc.crackleCurve, ageMult);
+    bool crackleVoicesActive = true;
+
+    // Dropout gain curves for this block (Cassette/VHS only); false while none is sounding
+    const float dropoutAmount = dropoutVal / 100.0f;
+    const float dropoutPerSample = dropoutRate.get([sampleRate](float amount, float age, float weight)
+    {
+        return amount > 0.01f ? kMaxDropoutsPerSecond * std::pow(amount / 100.0f, 1.5f) * age * weight / sampleRate : 0.0f;
+    }, dropoutVal, ageMult, dropoutWeight);
+    const bool dropoutActive = renderDropouts(numLaneChannels, numSamples, dropoutPerSample, dropoutAmount, linkChannels);
+
+    SampleType crackleActivityPeak = 0;
+    const auto dcGain = Vec::expand(1.0f - dcCoeff);
+
+    // One modulation value per sample: process() keeps sub-blocks within its size
+    jassert(numSamples <= static_cast<int>(cutoffModulation.size()));
+
+    // Stages 1-8 are interleaved per sample, so they're timed as one zone
+    OXIDE_TRACE_ZONE_BEGIN(sampleLoopZone, "Sample loop (stages 1-8)");
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Get smoothed values (advanced once per sample for all channels)
+        // (age, noise and saturation breathe with the input envelope when routed)
+        const float envelope = envelopeOn ? envelopeAt(i) : 0.0f;
+        const float ageNow = envelopeOn ? ageMultiplier(ageVal + envToAge * envelope) : ageMult;
+        const float bcAmount = bitcrushSmoothed.getNextValue() / 100.0f * ageNow;
+        const float dsAmount = downsampleSmoothed.getNextValue() / 100.0f * ageNow;
+        const float noiseAmount = juce::jlimit(0.0f, 100.0f, noiseSmoothed.getNextValue() + envToNoise * envelope)
+                                / 100.0f * ageNow * mc.hissAmount;
+        const float wobAmount = wobbleSmoothed.getNextValue() / 100.0f * mc.wobbleDepth * ageNow;
+        const float satAmount = juce::jlimit(0.0f, 100.0f, saturationSmoothed.getNextValue() + envToSaturation * envelope)
+                              / 100.0f * ageNow;
+        const float curveBlend = modeBlendSmoothed.getNextValue();
+
+        modulation.advance();
+        cutoffModulation[static_cast<size_t>(i)] = static_cast<float>(modulation.get(ModulationEngine<SampleType>::filterCutoff, 0));
+
+        for (int ch = 0; ch < numLaneChannels; ++ch)
+            frame[ch] = channelData[ch][i];
+
+        // =====================================================
+        // STAGE 1: BITCRUSHING
+        // =====================================================
+        if (bcAmount > 0.01f)
+        {
+            const auto& crush = bitcrushCoefficients.get(makeBitcrush, bcAmount, cleanCrush);
+
+            if (cleanCrush)
+            {
+                // TPDF dither, with the error fed back through (1 - z^-1) so the
+                // requantisation noise sits up the spectrum instead of tracking the signal
+                const auto limit = Vec::expand(kRoundLimit);
+
+                for (int ch = 0; ch < numLaneChannels; ++ch)
+                {
+                    auto& seed = ditherSeeds[static_cast<size_t>(ch)];
+                    noiseLanes[ch] = nextDither(seed) - nextDither(seed);
+                }
+
+                for (int g = 0; g < numGroups; ++g)
+                {
+                    const auto target = frame.group(g) * crush.levels - quantError.group(g);
+                    const auto dithered = Vec::min(Vec::max(target + noiseLanes.group(g), Vec::expand(-kRoundLimit)), limit);
+                    const auto quantised = roundLanes(dithered);
+
+                    quantError.group(g) = quantised - target;
+                    frame.group(g) = quantised * crush.step;
+                }
+            }
+            else
+            {
+                // Slight noise is added at low bit depths
+                for (int ch = 0; ch < numLaneChannels; ++ch)
+                {
+                    frame[ch] = std::round(frame[ch] * crush.levels) * crush.step;
+
+                    if (crush.noise > 0.0f)
+                        frame[ch] += noiseDist(noiseGen) * crush.noise;
+                }
+            }
+        }
+
+        // =====================================================
+        // STAGE 2: SAMPLE RATE REDUCTION
+        // =====================================================
+        if (dsAmount > 0.01f)
+        {
+            const auto& hold = downsampleCoefficients.get(makeDownsample, dsAmount);
+            const auto factor = Vec::expand(hold.factor);
+
+            // First sample of an epoch: hold (and settle the prefilters on) this one
+            if (i == 0 && resyncAtEpoch)
+            {
+                for (int g = 0; g < numGroups; ++g)
+                {
+                    holdPrefilter1.group(g) = frame.group(g);
+                    holdPrefilter2.group(g) = frame.group(g);
+                    lastSample.group(g) = frame.group(g);
+                    holdResidual.group(g) = Vec::expand(SampleType(0));
+                }
+            }
+
+            if (cleanCrush)
+            {
+                // Two one-poles near the new Nyquist take out most of what the hold would
+                // fold back, then each step is spread over the samples either side of it
+                // with a polyBLEP residual. The hold latches one sample early (inaudible
+                // for a held value) so the pre-step half needs no lookahead or latency.
+                const auto coeff = Vec::expand(hold.prefilter);
+                const auto one = Vec::expand(1);
+                const auto half = Vec::expand(SampleType(0.5));
+
+                for (int g = 0; g < numGroups; ++g)
+                {
+                    auto& lp1 = holdPrefilter1.group(g);
+                    auto& lp2 = holdPrefilter2.group(g);
+                    lp1 = frame.group(g) + (lp1 - frame.group(g)) * coeff;
+                    lp2 = lp1 + (lp2 - lp1) * coeff;
+
+                    auto& held = lastSample.group(g);
+                    auto& counter = sampleHoldCounter.group(g);
+                    auto& residual = holdResidual.group(g);
+
+                    // d: how far before the next sample the step lands (0-1)
+                    const auto next = counter + one;
+                    const auto latch = Vec::greaterThanOrEqual(next, factor);
+                    const auto d = Vec::min((next - factor) & latch, one);
+                    const auto step = (lp2 - held) & latch;
+                    const auto rest = one - d;
+
+                    frame.group(g) = held + residual + step * d * d * half;
+                    residual = step * rest * rest * SampleType(-0.5);
+                    held += step;
+                    counter = next - (factor & latch);
+                }
+            }
+            else
+            {
+                for (int g = 0; g < numGroups; ++g)
+                {
+                    auto& counter = sampleHoldCounter.group(g);
+                    counter += 1.0f;
+
+                    const auto latch = Vec::greaterThanOrEqual(counter, factor);
+                    lastSample.group(g) = (frame.group(g) & latch) + (lastSample.group(g) & ~latch);
+                    counter -= factor & latch;
+                    frame.group(g) = lastSample.group(g);
+                }
+            }
+        }
+
+        // =====================================================
+        // STAGE 3: WOW & FLUTTER (Pitch Modulation)
+        // Always read through the line, exactly kWobbleBaseDelay back when wobble
+        // is off, so the latency doesn't change with the wobble amount. The
+        // hysteresis engine's input is read its filter delay earlier, so its
+        // output lines up with this read
+        // =====================================================
+        const bool wobbleOn = wobAmount > 0.01f;
+        const bool hysteresisOn = tapeHysteresis && satAmount > 0.01f;
+
+        for (int ch = 0; ch < numLaneChannels; ++ch)
+        {
+            auto* line = delayLines.data() + static_cast<size_t>(ch) * kMaxDelaySize;
+            line[delayWritePos] = frame[ch];
+
+            // Calculate modulated read position
+            const float totalMod = wobbleOn
+                ? static_cast<float>(modulation.get(ModulationEngine<SampleType>::wobbleDelay, ch)) * wobAmount
+                : 0.0f;
+
+            // Linear interpolation read
+            const auto readAt = [&](float delay)
+            {
+                const float readPosFloat = static_cast<float>(delayWritePos) - (delay + totalMod);
+                int readPos = static_cast<int>(std::floor(readPosFloat));
+                const float frac = readPosFloat - static_cast<float>(readPos);
+
+                // Wrap (power-of-two size)
+                readPos &= kMaxDelaySize - 1;
+                const int readPosNext = (readPos + 1) & (kMaxDelaySize - 1);
+
+                return line[readPos] * (1.0f - frac) + line[readPosNext] * frac;
+            };
+
+            frame[ch] = readAt(static_cast<float>(kWobbleBaseDelay));
+
+            if (hysteresisOn)
+                hysteresisLanes[ch] = readAt(static_cast<float>(kWobbleBaseDelay - TapeHysteresis<SampleType>::kLatencySamples));
+        }
+
+        delayWritePos = (delayWritePos + 1) & (kMaxDelaySize - 1);
+
+        // =====================================================
+        // STAGE 4: SATURATION (Mode-dependent)
+        // =====================================================
+        if (satAmount > 0.01f)
+        {
+            const auto& drive = saturationDrive.get([](float amount) { return DriveCoefficients { 1.0f + amount * 5.0f, 1.0f / (1.0f + amount * 5.0f) }; },
+                                                    satAmount);
+
+            // Hysteresis engine: the tape modes take the magnetisation instead of their curve
+            if (hysteresisOn)
+            {
+                for (int g = 0; g < numGroups; ++g)
+                    hysteresisLanes.group(g) *= static_cast<SampleType>(drive.drive);
+
+                hysteresis.process(hysteresisLanes, hysteresisLanes, numLaneChannels, satAmount);
+            }
+
+            for (int ch = 0; ch < numLaneChannels; ++ch)
+            {
+                const SampleType driven = frame[ch] * drive.drive;
+                const auto shape = [&](int m)
+                {
+                    return tapeHysteresis && isTape(m) ? hysteresisLanes[ch] : applySaturationCurve(m, driven, satAmount);
+                };
+
+                // Mode-dependent saturation curve, crossfaded while morphing between modes
+                const SampleType shaped = modeA == modeB
+                    ? shape(modeA)
+                    : shape(modeA) * (1.0f - curveBlend) + shape(modeB) * curveBlend;
+
+                // Makeup gain
+                frame[ch] = shaped * drive.makeup;
+            }
+        }
+
+        // =====================================================
+        // STAGE 5: DROPOUT (Tape/VHS)
+        // =====================================================
+        if (dropoutActive)
+        {
+            for (int ch = 0; ch < numLaneChannels; ++ch)
+                dropoutLanes[ch] = dropoutGains.getReadPointer(linkChannels ? 0 : ch)[i];
+
+            for (int g = 0; g < numGroups; ++g)
+                frame.group(g) *= dropoutLanes.group(g);
+        }
+
+        // =====================================================
+        // STAGE 6: NOISE & HISS
+        // =====================================================
+        if (noiseAmount > 0.001f)
+        {
+            for (int ch = 0; ch < numLaneChannels; ++ch)
+                noiseLanes[ch] = noiseDist(noiseGen);
+
+            for (int g = 0; g < numGroups; ++g)
+            {
+                auto noiseOut = noiseLanes.group(g);
+
+                // Pink-ish noise: simple 1-pole lowpass over white
+                if (pinkNoise)
+                {
+                    pinkState.group(g) = pinkState.group(g) * 0.9f + noiseOut * 0.1f;
+                    noiseOut = pinkState.group(g) * 3.0f;
+                }
+
+                frame.group(g) += noiseOut * modulation.get(ModulationEngine<SampleType>::noiseLevel).group(g)
+                                * static_cast<SampleType>(noiseAmount * 0.05f);
+            }
+        }
+
+        // =====================================================
+        // STAGE 7: CRACKLE & POPS (Vinyl mode)
+        // =====================================================
+        if (crackleVal > 0.01f || crackleVoicesActive)
+        {
+            crackleVoicesActive = false;
+
+            for (int ch = 0; ch < numLaneChannels; ++ch)
+            {
+                // Linked channels share channel 0's events
+                if (cracklePerSample > 0.0f && (ch == 0 || ! linkChannels))
+                {
+                    auto& hazard = crackleHazard[static_cast<size_t>(ch)];
+                    hazard -= cracklePerSample;
+
+                    if (hazard <= 0.0f)
+                    {
+                        hazard += drawCrackleHazard();
+
+                        if (linkChannels)
+                            for (int linked = 0; linked < numLaneChannels; ++linked)
+                                triggerCrackle(linked, crackleAmount);
+                        else
+                            triggerCrackle(ch, crackleAmount);
+                    }
+                }
+
+                // Mix the pops that are still sounding
+                SampleType crackleOut = 0;
+                auto* voices = crackleVoices.data() + ch * kMaxCrackleVoices;
+
+                for (int v = 0; v < kMaxCrackleVoices; ++v)
+                {
+                    auto& voice = voices[v];
+                    if (voice.remaining <= 0)
+                        continue;
+
+                    crackleOut += *voice.impulse++ * voice.gain;
+                    --voice.remaining;
+                    crackleVoicesActive = true;
+                }
+
+                frame[ch] += crackleOut;
+                crackleActivityPeak = std::max(crackleActivityPeak, std::abs(crackleOut));
+            }
+        }
+
+        // =====================================================
+        // STAGE 8: DC BLOCKING
+        // =====================================================
+        for (int g = 0; g < numGroups; ++g)
+        {
+            const auto dcInput = frame.group(g);
+            frame.group(g) = dcInput - dcState.group(g);
+            dcState.group(g) = dcInput * dcGain;
+        }
+
+        for (int ch = 0; ch < numLaneChannels; ++ch)
+            channelData[ch][i] = frame[ch];
+
+    }
+
+    OXIDE_TRACE_ZONE_END(sampleLoopZone);
+
+    resyncAtEpoch = false;
+
+    if (crackleVal > 0.01f)
+        meters.crackleActivity = static_cast<float>(crackleActivityPeak);
+
+    meters.wobblePhase = modulation.getWowPhase();
+
+    // =========================================================================
+    // STAGE 9: FILTERING
+    // =========================================================================
+    // Cutoff wanders with the tape transport, more as wobble goes up
+    const float filterWander = kFilterWanderDepth * wobbleVal / 100.0f * mc.wobbleDepth * ageMult;
+
+    if (lowpassResonance.update([](float res) { return 0.5f + res / 100.0f * (kMaxResonance - 0.5f); }, filterResVal))
+        lowpassFilter.setResonance(static_cast<SampleType>(lowpassResonance.value));
+
+    // Apply filter drive (pre-filter saturation)
+    if (filterDriveVal > 1.0f)
+    {
+        OXIDE_TRACE_ZONE("Filter drive");
+        const auto& drive = filterDrive.get([](float amount) { return DriveCoefficients { 1.0f + amount / 10.0f, 1.0f / (1.0f + amount / 10.0f) }; },
+                                            filterDriveVal);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = std::tanh(data[i] * drive.drive) * drive.makeup;
+        }
+    }
+
+    // Apply lowpass, retuned once per control interval
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+    juce::dsp::ProcessContextReplacing<SampleType> context(block);
+
+    OXIDE_TRACE_ZONE_BEGIN(lowpassZone, "Lowpass");
+
+    for (int start = 0; start < numSamples; start += ModulationEngine<SampleType>::kControlInterval)
+    {
+        const int length = std::min(ModulationEngine<SampleType>::kControlInterval, numSamples - start);
+        const float cutoffNorm = filterCutoffSmoothed.skip(length) / 100.0f
+                               + cutoffModulation[static_cast<size_t>(start)] * filterWander
+                               + (envelopeOn ? envToFilter / 100.0f * envelopeAt(start) : 0.0f);
+
+        // Map cutoff 0-1 to 200Hz - 20kHz with mode influence
+        const auto mapCutoff = [](float norm, float ceiling) { return std::min(kMinCutoffHz * std::pow(100.0f, norm), ceiling); };
+
+        if (lowpassCutoff.update(mapCutoff, juce::jlimit(0.0f, 1.0f, cutoffNorm), mc.lpFreq))
+            lowpassFilter.setCutoffFrequency(static_cast<SampleType>(lowpassCutoff.value));
+
+        auto subBlock = block.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(length));
+        juce::dsp::ProcessContextReplacing<SampleType> subContext(subBlock);
+        lowpassFilter.process(subContext);
+    }
+
+    OXIDE_TRACE_ZONE_END(lowpassZone);
+
+    // Mode high-pass: light for most modes, high enough on Radio to band-limit it
+    OXIDE_TRACE_ZONE_BEGIN(highpassZone, "Highpass");
+
+    if (highpassCutoff.update([](float hz) { return hz; }, mc.hpFreq))
+        highpassFilter.setCutoffFrequency(static_cast<SampleType>(highpassCutoff.value));
+
+    highpassFilter.process(context);
+    OXIDE_TRACE_ZONE_END(highpassZone);
+
+    // =========================================================================
+    // STAGE 10: DRY/WET MIX
+    // =========================================================================
+    OXIDE_TRACE_ZONE_BEGIN(mixZone, "Dry/wet mix");
+    const float mixNorm = mixSmoothed.getNextValue() / 100.0f;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* wet = buffer.getWritePointer(ch);
+        const auto* dry = dryBuffer.getReadPointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            wet[i] = wet[i] * mixNorm + dry[i] * (1.0f - mixNorm);
+        }
+    }
+
+    OXIDE_TRACE_ZONE_END(mixZone);
+
+    // =========================================================================
+    // STAGE 11: OUTPUT GAIN
+    // =========================================================================
+    OXIDE_TRACE_ZONE("Output gain");
+    buffer.applyGain(outputGain.get([](float db) { return juce::Decibels::decibelsToGain(static_cast<SampleType>(db)); },
+                                    outputVal));
+
+    return meters;
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::followEnvelope(const juce::AudioBuffer<SampleType>& input, int numSamples,
+                                          float attackMs, float releaseMs, bool rms)
+{
+    OXIDE_TRACE_ZONE("Envelope follower");
+    constexpr int interval = ModulationEngine<SampleType>::kControlInterval;
+    const auto coefficientFor = [this](float ms)
+    {
+        return static_cast<float>(std::exp(-interval / (juce::jmax(0.1f, ms) * 0.001 * currentSampleRate)));
+    };
+    const float attack = coefficientFor(attackMs);
+    const float release = coefficientFor(releaseMs);
+    const int numChannels = juce::jmin(input.getNumChannels(), numPreparedChannels);
+
+    // Sized for preparedBlockSize; process() never hands us more than that
+    const int numPoints = static_cast<int>(envelopeTrace.size());
+    jassert(numSamples / interval + 2 <= numPoints);
+
+    envelopeTrace[0] = envelopeState;
+
+    for (int start = 0, k = 1; start < numSamples && k < numPoints; start += interval, ++k)
+    {
+        // Same detectors as the input meter, run over one control interval
+        const int length = juce::jmin(interval, numSamples - start);
+        float level = 0.0f;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (rms)
+                level += static_cast<float>(input.getRMSLevel(ch, start, length));
+            else
+                level = juce::jmax(level, static_cast<float>(input.getMagnitude(ch, start, length)));
+        }
+
+        if (rms && numChannels > 0)
+            level /= static_cast<float>(numChannels);
+
+        // -60..0 dBFS onto 0..1
+        const float target = juce::jlimit(0.0f, 1.0f, juce::Decibels::gainToDecibels(level, -60.0f) / 60.0f + 1.0f);
+        const float coeff = target > envelopeState ? attack : release;
+        envelopeState = target + (envelopeState - target) * coeff;
+        envelopeTrace[static_cast<size_t>(k)] = envelopeState;
+    }
+}
+
+template <typename SampleType>
+float OxideDsp<SampleType>::envelopeAt(int sample) const noexcept
+{
+    // Linear ramp between control points
+    constexpr int interval = ModulationEngine<SampleType>::kControlInterval;
+    const auto k = static_cast<size_t>(juce::jmin(sample / interval, static_cast<int>(envelopeTrace.size()) - 2));
+    const float frac = static_cast<float>(sample % interval) / static_cast<float>(interval);
+    return envelopeTrace[k] + (envelopeTrace[k + 1] - envelopeTrace[k]) * frac;
+}
+
+template <typename SampleType>
+typename OxideDsp<SampleType>::DropoutEvent OxideDsp<SampleType>::drawDropout(float amount)
+{
+    // Length and depth are fixed for the whole event; more dropout = longer gaps
+    const auto toSamples = [this](float ms) { return juce::jmax(1, juce::roundToInt(ms * 0.001 * currentSampleRate)); };
+    const float holdMs = 20.0f + crackleChance(eventGen) * (60.0f + 200.0f * amount);
+
+    DropoutEvent event;
+    event.position = 0;
+    event.fadeOutLength = toSamples(kDropoutFadeOutMs);
+    event.holdLength = toSamples(holdMs);
+    event.fadeInLength = toSamples(kDropoutFadeInMs);
+    event.depth = 0.6f + 0.4f * crackleChance(eventGen);
+    return event;
+}
+
+template <typename SampleType>
+bool OxideDsp<SampleType>::renderDropouts(int numChannels, int numSamples, float eventsPerSample, float amount, bool linked)
+{
+    OXIDE_TRACE_ZONE("Dropout render");
+    const int numSources = linked ? juce::jmin(1, numChannels) : numChannels;
+    const float blockEvents = eventsPerSample * static_cast<float>(numSamples);
+
+    bool anyActive = false;
+    for (int ch = 0; ch < numSources; ++ch)
+    {
+        const auto& event = dropoutEvents[static_cast<size_t>(ch)];
+        anyActive = anyActive || event.position >= 0 || event.hazard < blockEvents;
+    }
+
+    // Common case: nothing sounding and nothing due, just move the schedules on
+    if (! anyActive)
+    {
+        for (int ch = 0; ch < numSources; ++ch)
+            dropoutEvents[static_cast<size_t>(ch)].hazard -= blockEvents;
+        return false;
+    }
+
+    for (int ch = 0; ch < numSources; ++ch)
+    {
+        auto& event = dropoutEvents[static_cast<size_t>(ch)];
+        auto* gain = dropoutGains.getWritePointer(ch);
+        int i = 0;
+
+        // Renders the current dropout (or unity gain once it ends) up to sample `end`
+        const auto renderUntil = [&](int end)
+        {
+            while (i < end)
+            {
+                if (event.position < 0)
+                {
+                    std::fill(gain + i, gain + end, SampleType(1));
+                    i = end;
+                    break;
+                }
+
+                // Quick fade out, hold, slower fade back in
+                const int n = juce::jmin(end - i, event.getTotalLength() - event.position);
+                for (int k = 0; k < n; ++k, ++event.position)
+                {
+                    const int p = event.position;
+                    float shape = 1.0f;
+
+                    if (p < event.fadeOutLength)
+                        shape = tables->fade(static_cast<float>(p) / static_cast<float>(event.fadeOutLength));
+                    else if (p >= event.fadeOutLength + event.holdLength)
+                        shape = 1.0f - tables->fade(static_cast<float>(p - event.fadeOutLength - event.holdLength)
+                                                    / static_cast<float>(event.fadeInLength));
+
+                    gain[i + k] = static_cast<SampleType>(1.0f - event.depth * shape);
+                }
+                i += n;
+
+                if (event.position >= event.getTotalLength())
+                    event.position = -1;
+            }
+        };
+
+        while (i < numSamples)
+        {
+            // The schedule keeps counting during a dropout, so when events land
+            // depends only on the draws and not on what was already sounding
+            const float remaining = static_cast<float>(numSamples - i);
+            const float samplesToNext = eventsPerSample > 0.0f ? event.hazard / eventsPerSample : remaining;
+            const bool fires = samplesToNext < remaining;
+            const int end = fires ? i + static_cast<int>(samplesToNext) : numSamples;
+
+            event.hazard -= eventsPerSample * static_cast<float>(end - i);
+            renderUntil(end);
+
+            if (fires)
+            {
+                // Always drawn so the event stream stays in step; a dropout landing
+                // inside another one is skipped
+                const auto next = drawDropout(amount);
+                if (event.position < 0)
+                    event = next;
+
+                event.hazard = drawCrackleHazard();
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+void OxideDsp<SampleType>::triggerCrackle(int channel, float amount)
+{
+    const int index = juce::jmin(static_cast<int>(crackleChance(eventGen) * SharedTables<SampleType>::kNumCrackleImpulses),
+                                 SharedTables<SampleType>::kNumCrackleImpulses - 1);
+    const auto impulse = tables->getCrackleImpulse(index);
+
+    // Reuse a free voice, or steal the one closest to finishing
+    auto* voices = crackleVoices.data() + channel * kMaxCrackleVoices;
+    auto* target = voices;
+    for (int v = 0; v < kMaxCrackleVoices; ++v)
+        if (voices[v].remaining < target->remaining)
+            target = voices + v;
+
+    // Generate a pop
+    const float level = (0.3f + crackleChance(eventGen) * 0.7f) * (crackleChance(eventGen) > 0.5f ? 1.0f : -1.0f);
+    target->impulse = impulse.data;
+    target->remaining = impulse.length;
+    target->gain = static_cast<SampleType>(level * amount);
+}
+
+template <typename SampleType>
+SampleType OxideDsp<SampleType>::applySaturationCurve(int mode, SampleType driven, float satAmount) const noexcept
+{
+    SampleType shaped = tables->saturate(mode, driven);
+
+    // Cassette: even harmonics for warmth
+    if (mode == 0)
+        shaped += 0.1f * satAmount * shaped * std::abs(shaped);
+
+    return shaped;
+}
+
+template class OxideDsp<float>;
+template class OxideDsp<double>;
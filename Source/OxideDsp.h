@@ -0,0 +1,353 @@
+#pragma once
+
+#include "ChannelLanes.h"
+#include "ModulationEngine.h"
+#include "ParameterSnapshot.h"
+#include "SharedTables.h"
+#include "TapeHysteresis.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <random>
+#include <tuple>
+#include <vector>
+
+/**
+    The Oxide degradation chain (bitcrush through output gain), templated on
+    sample type so the processor can run natively in single or double precision.
+
+    Owns every piece of per-channel DSP state. Parameters arrive once per block as
+    a ParameterSnapshot (already morphed by the processor); the per-sample path
+    never allocates.
+*/
+template <typename SampleType>
+class OxideDsp
+{
+public:
+    // Per-mode character: 0=Cassette, 1=Vinyl, 2=VHS, 3=Radio
+    struct ModeChar
+    {
+        float noiseColor = 1.0f;      // 0=pink, 1=white, 0.5=tape
+        float wobbleDepth = 1.0f;     // Pitch modulation depth
+        float wobbleRate = 1.0f;      // Pitch modulation rate
+        float satCurve = 0.5f;        // Saturation curve type
+        float hpFreq = 20.0f;         // High-pass frequency
+        float lpFreq = 20000.0f;      // Low-pass frequency
+        float hissAmount = 1.0f;      // Noise character
+        float crackleDensity = 0.0f;  // Crackle events per second at full amount
+        float crackleCurve = 1.0f;    // Density curve exponent over the crackle amount
+
+        static ModeChar interpolate(const ModeChar& a, const ModeChar& b, float t) noexcept
+        {
+            const auto lerp = [t](float x, float y) { return x + (y - x) * t; };
+            return { lerp(a.noiseColor, b.noiseColor), lerp(a.wobbleDepth, b.wobbleDepth),
+                     lerp(a.wobbleRate, b.wobbleRate), lerp(a.satCurve, b.satCurve),
+                     lerp(a.hpFreq, b.hpFreq), lerp(a.lpFreq, b.lpFreq),
+                     lerp(a.hissAmount, b.hissAmount),
+                     lerp(a.crackleDensity, b.crackleDensity), lerp(a.crackleCurve, b.crackleCurve) };
+        }
+    };
+
+    // What a block should do: the parameters plus the modes either side of a morph
+    struct BlockSettings
+    {
+        ParameterSnapshot params;
+        int modeA = 0;
+        int modeB = 0;
+        float modeBlend = 0.0f;       // 0 = modeA, 1 = modeB
+    };
+
+    // Visualizer values produced by a block
+    struct BlockMeters
+    {
+        float crackleActivity = -1.0f;  // negative while crackle is off (meter keeps its value)
+        float wobblePhase = 0.0f;
+        float degradation = 0.0f;
+    };
+
+    OxideDsp();
+
+    void prepare(double sampleRate, int maxBlockSize, int numChannels, const ParameterSnapshot& initial);
+    void reset();
+
+    /** Frees the per-channel buffers (used for the core that doesn't match the host's precision). */
+    void release();
+
+    /** Blocks longer than the prepared maxBlockSize (which some hosts send despite
+        announcing it) are processed in pieces of at most that size, so the
+        per-block scratch buffers never need to grow on the audio thread. */
+    BlockMeters process(juce::AudioBuffer<SampleType>& buffer, const BlockSettings& settings);
+
+    /** Offline rendering: reseeds every random source from the seed and an absolute
+        sample position, realigns the position-dependent state (sample-and-hold
+        phase, modulation timeline) and restarts state that would otherwise
+        remember the whole render (noise-shaping error, held value, hysteresis).
+        Called at fixed epoch boundaries, this makes a render reproducible from any
+        epoch after a warm-up, so it can be split into chunks. */
+    void beginEpoch(juce::uint64 seed, juce::int64 samplePosition);
+
+    static const ModeChar& getModeChar(int mode) noexcept;
+
+    /** Fixed processing latency: the wet path runs through the wow/flutter delay line
+        at its centre position, and the dry path is delayed to match.
+
+        This costs 512 samples (about 11 ms at 48 kHz) even with Wobble at 0, where
+        nothing needs the delay. A latency that followed Wobble was rejected: hosts
+        only pick up a latency change between playback runs (some only on reload),
+        so until then the output would be misaligned by up to 512 samples, and
+        moving the read point when Wobble leaves 0 would jump the wet signal by
+        that much, an audible click or skip mid-playback. A fixed delay also keeps
+        the dry/wet mix and bypass phase-aligned at every setting. The hysteresis
+        engine's oversampling filters fit inside it: their input is read from the
+        line that much earlier, so they add nothing. */
+    static constexpr int getLatencySamples() noexcept { return kWobbleBaseDelay; }
+
+    /** How long output keeps responding after the input stops: the latency plus the
+        deepest wobble excursion, then the lowpass ringing out to -60 dB at its lowest
+        cutoff and highest resonance. Hiss and crackle are generated, not a tail. */
+    static double getTailSeconds(double sampleRate) noexcept;
+
+    /** Bypassed blocks still go through the dry delay, so bypassing doesn't shift timing. */
+    void processBypassed(juce::AudioBuffer<SampleType>& buffer);
+
+private:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    // One block of at most preparedBlockSize samples
+    BlockMeters processSubBlock(juce::AudioBuffer<SampleType>& buffer, const BlockSettings& settings);
+    int preparedBlockSize = 0;
+
+    // A value derived from parameters, recomputed only when one of its inputs
+    // changes (or after invalidate). Inputs compare exactly, so a value fed by a
+    // settled smoother costs one comparison per use.
+    template <typename Value, typename... Inputs>
+    struct Derived
+    {
+        // Returns true when the value was recomputed
+        template <typename Compute>
+        bool update(Compute&& compute, Inputs... newInputs)
+        {
+            const std::tuple<Inputs...> key { newInputs... };
+
+            if (valid && key == inputs)
+                return false;
+
+            inputs = key;
+            value = compute(newInputs...);
+            valid = true;
+            return true;
+        }
+
+        template <typename Compute>
+        const Value& get(Compute&& compute, Inputs... newInputs)
+        {
+            update(std::forward<Compute>(compute), newInputs...);
+            return value;
+        }
+
+        void invalidate() noexcept { valid = false; }
+
+        std::tuple<Inputs...> inputs {};
+        Value value {};
+        bool valid = false;
+    };
+
+    struct BitcrushCoefficients
+    {
+        SampleType levels = 1;          // quantiser steps per unit
+        SampleType step = 1;            // 1 / levels
+        float noise = 0.0f;             // extra noise at low bit depths (raw crush only)
+    };
+
+    struct DownsampleCoefficients
+    {
+        float factor = 1.0f;            // hold length in samples
+        SampleType prefilter = 0;       // one-pole coefficient near the new Nyquist (clean crush only)
+    };
+
+    struct DriveCoefficients
+    {
+        float drive = 1.0f;
+        float makeup = 1.0f;            // 1 / drive
+    };
+
+    static BitcrushCoefficients makeBitcrush(float amount, bool clean) noexcept;
+    static DownsampleCoefficients makeDownsample(float amount) noexcept;
+
+    void invalidateDerived() noexcept;
+
+    SampleType applySaturationCurve(int mode, SampleType driven, float satAmount) const noexcept;
+
+    // === Hot: read or written every sample ===
+    // The lane values all live in laneState, one cache-line-aligned block packed in
+    // prepare; the members here are just their handles, kept together with the
+    // smoothers and positions so the sample loop's working set stays contiguous.
+    alignas(64) int numPreparedChannels = 0;
+    ChannelLaneBlock<SampleType> laneState;
+
+    ChannelLanes<SampleType> frame;             // current sample of every channel
+    ChannelLanes<SampleType> noiseLanes;        // per-channel noise draws
+
+    // Sample rate reduction
+    ChannelLanes<SampleType> lastSample;
+    ChannelLanes<SampleType> sampleHoldCounter;
+    ChannelLanes<SampleType> pinkState;
+
+    // Clean crush: TPDF-dithered quantiser with first-order noise shaping, and a
+    // prefiltered hold whose steps are smoothed with a polyBLEP residual
+    ChannelLanes<SampleType> quantError;
+    ChannelLanes<SampleType> holdPrefilter1;
+    ChannelLanes<SampleType> holdPrefilter2;
+    ChannelLanes<SampleType> holdResidual;
+    std::vector<juce::uint32> ditherSeeds;
+    bool resyncAtEpoch = false;                 // beginEpoch ran; restart the hold on the next sample
+
+    ChannelLanes<SampleType> hysteresisLanes;   // hysteresis output for the tape modes
+    ChannelLanes<SampleType> dropoutLanes;      // this sample's dropout gains
+
+    // DC blocker
+    ChannelLanes<SampleType> dcState;
+    SampleType dcCoeff = SampleType(0.995);
+
+    // Smoothed parameters
+    juce::SmoothedValue<float> bitcrushSmoothed;
+    juce::SmoothedValue<float> downsampleSmoothed;
+    juce::SmoothedValue<float> noiseSmoothed;
+    juce::SmoothedValue<float> wobbleSmoothed;
+    juce::SmoothedValue<float> saturationSmoothed;
+    juce::SmoothedValue<float> filterCutoffSmoothed;
+    juce::SmoothedValue<float> mixSmoothed;
+    juce::SmoothedValue<float> modeBlendSmoothed;
+
+    // === Cold: set up in prepare, touched per block or per event ===
+    double currentSampleRate = 44100.0;
+
+    // Process-wide read-only tables (saturation curves, fades, crackle bank) for this sample rate
+    std::shared_ptr<const SharedTables<SampleType>> tables;
+
+    // Hysteresis saturation engine for the tape modes (driven field in, magnetisation out)
+    TapeHysteresis<SampleType> hysteresis;
+
+    static constexpr float kMaxCleanBits = 20.0f;               // finer steps are inaudible anyway
+    static constexpr SampleType kRoundLimit = SampleType(4194304); // 2^22 steps: +12 dBFS at 20 bits
+
+    // Round to nearest across a register: adding and removing 1.5 * 2^mantissaBits
+    // pushes the fraction out of the mantissa (valid while |x| < 2^22)
+    static Vec roundLanes(Vec x) noexcept
+    {
+        constexpr SampleType magic = sizeof(SampleType) == 4 ? SampleType(12582912.0) : SampleType(6755399441055744.0);
+        return (x + magic) - magic;
+    }
+
+    // Uniform [0, 1) from a per-channel LCG, cheap enough to draw every sample
+    static SampleType nextDither(juce::uint32& seed) noexcept
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<SampleType>(seed >> 8) * SampleType(1.0 / 16777216.0);
+    }
+
+    // Dry copy for the mix stage (preallocated)
+    juce::AudioBuffer<SampleType> dryBuffer;
+
+    // Random generators: per-sample noise, and crackle/dropout events (kept apart
+    // so the event schedule doesn't depend on which noise stages are running)
+    std::mt19937 noiseGen;
+    std::mt19937 eventGen;
+    std::uniform_real_distribution<float> noiseDist { -1.0f, 1.0f };
+    std::uniform_real_distribution<float> crackleChance { 0.0f, 1.0f };
+
+    // Input envelope follower: one value per control interval, shared by all
+    // channels; element 0 carries the last value of the previous block. Sized
+    // for preparedBlockSize (process() splits anything longer).
+    std::vector<float> envelopeTrace;
+    float envelopeState = 0.0f;
+
+    void followEnvelope(const juce::AudioBuffer<SampleType>& input, int numSamples,
+                        float attackMs, float releaseMs, bool rms);
+    float envelopeAt(int sample) const noexcept;
+
+    // Control-rate wow/flutter, filter wander and hiss breathing
+    ModulationEngine<SampleType> modulation;
+    std::vector<float> cutoffModulation;         // per sample of the (sub-)block, for the filter stage; preparedBlockSize long
+    static constexpr float kFilterWanderDepth = 0.05f;   // normalised cutoff at full wobble
+
+    // Pitch shifting delay line for wow/flutter (kMaxDelaySize per channel), read
+    // around kWobbleBaseDelay; the dry path has a matching fixed delay
+    static constexpr int kMaxDelaySize = 4096;
+    static constexpr int kWobbleBaseDelay = 512;
+    static constexpr int kMaxWobbleExcursion = 138;    // deepest modulation: 23 samples x VHS depth 2 x age 3
+    static_assert(kWobbleBaseDelay - TapeHysteresis<SampleType>::kLatencySamples > kMaxWobbleExcursion + 1,
+                  "The hysteresis engine's early read must stay behind the write position");
+    std::vector<SampleType> delayLines;
+    int delayWritePos = 0;
+    std::vector<SampleType> dryDelayLines;
+    int dryDelayPos = 0;
+
+    void delayDry(juce::AudioBuffer<SampleType>& signal, int numSamples) noexcept;
+
+    // Lowpass range (cutoff at 0%, resonance at 100%), also used for the tail length
+    static constexpr float kMinCutoffHz = 200.0f;
+    static constexpr float kMaxResonance = 10.0f;
+
+    // Dropouts: events are scheduled ahead with their length and depth fixed when
+    // drawn, and each block's gain curve is rendered before the sample loop
+    struct DropoutEvent
+    {
+        float hazard = 1.0f;        // unit-rate time left until the next dropout
+        int position = -1;          // sample within the current dropout, -1 when idle
+        int fadeOutLength = 0;
+        int holdLength = 0;
+        int fadeInLength = 0;
+        float depth = 0.0f;         // 0 = untouched, 1 = full dropout
+
+        int getTotalLength() const noexcept { return fadeOutLength + holdLength + fadeInLength; }
+    };
+    std::vector<DropoutEvent> dropoutEvents;      // one per channel (channel 0 drives all when linked)
+    juce::AudioBuffer<SampleType> dropoutGains;   // rendered per (sub-)block, preparedBlockSize long
+
+    static constexpr float kMaxDropoutsPerSecond = 3.0f;
+    static constexpr float kDropoutFadeOutMs = 3.0f;
+    static constexpr float kDropoutFadeInMs = 25.0f;
+
+    bool renderDropouts(int numChannels, int numSamples, float eventsPerSample, float amount, bool linked);
+    DropoutEvent drawDropout(float amount);
+
+    // Crackle: each channel counts down an exponentially distributed hazard and
+    // fires a pop from the shared impulse bank when it runs out, so random draws
+    // happen per event rather than per sample.
+    struct CrackleVoice
+    {
+        const SampleType* impulse = nullptr;
+        int remaining = 0;
+        SampleType gain = 0;
+    };
+    static constexpr int kMaxCrackleVoices = 8;    // per channel
+    std::vector<CrackleVoice> crackleVoices;
+    std::vector<float> crackleHazard;
+
+    void triggerCrackle(int channel, float amount);
+    float drawCrackleHazard() { return -std::log(1.0f - crackleChance(eventGen) * 0.9999f); }
+
+    // Filters
+    juce::dsp::StateVariableTPTFilter<SampleType> lowpassFilter;
+    juce::dsp::StateVariableTPTFilter<SampleType> highpassFilter;  // For radio mode
+    juce::dsp::StateVariableTPTFilter<SampleType> bandpassFilter;  // For radio mode
+    juce::dsp::StateVariableTPTFilter<SampleType> tapeHeadFilter;  // Tape head bump
+
+    // Derived coefficients: per-sample ones keyed on the smoothed amounts, the rest
+    // on the block's parameters. The filter entries hold what was last handed to
+    // the filter, so it's only retuned when that changes.
+    Derived<BitcrushCoefficients, float, bool> bitcrushCoefficients;
+    Derived<DownsampleCoefficients, float> downsampleCoefficients;
+    Derived<DriveCoefficients, float> saturationDrive;
+    Derived<ModeChar, int, int, float> modeCharacter;
+    Derived<float, float, float, float, float> crackleRate;       // crackle, density, curve, age multiplier
+    Derived<float, float, float, float> dropoutRate;              // dropout, age multiplier, tape weight
+    Derived<DriveCoefficients, float> filterDrive;
+    Derived<float, float> lowpassResonance;
+    Derived<float, float, float> lowpassCutoff;                   // normalised cutoff, mode ceiling
+    Derived<float, float> highpassCutoff;
+    Derived<SampleType, float> outputGain;
+
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OxideDsp)
+};
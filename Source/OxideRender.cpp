@@ -0,0 +1,1313 @@
+/*
+    OxideRender: offline render of one audio file through the Oxide DSP core,
+    split across cores, or a streaming PCM filter for pipelines.
+
+        OxideRender <input> <output.wav> [--preset <index|name>] [--set <id>=<value>]...
+                    [--threads <n>] [--seed <n>] [--verify]
+
+        OxideRender --verify --test-signal <seconds> [--preset <index|name>] [--set <id>=<value>]...
+                    [--threads <n>] [--seed <n>]
+
+        OxideRender --stream [--rate <hz>] [--channels <n>] [--format f32|s16] [--block <frames>]
+                    [--state <file>] [--preset <index|name>] [--set <id>=<value>]...
+
+        OxideRender --state-stress [--seconds <n>] [--rate <hz>] [--block <frames>] [--strict-timing]
+
+        OxideRender --state-bench [--iterations <n>]
+
+        OxideRender --bench [--precision float|double] [--engines] [--seconds <n>] [--rate <hz>] [--block <frames>]
+                    [--channels <n>] [--preset <index|name>] [--set <id>=<value>]...
+
+        OxideRender --instances <n> [--seconds <n>] [--rate <hz>] [--block <frames>]
+                    [--preset <index|name>] [--set <id>=<value>]...
+
+        OxideRender --check-extremes
+
+    The file is cut into chunks aligned to fixed epochs (kEpochLength samples).
+    At every epoch boundary the DSP reseeds its random sources from the seed and
+    the absolute position, so each worker can start a few epochs early with its
+    own OxideDsp, let filters, delay lines and followers settle on that overlap,
+    and then produce the same samples a serial render would. Chunks are written
+    out in order as they finish.
+
+    --verify renders the file serially as well and compares the two, exiting
+    with an error if they differ by more than kVerifyToleranceDb. With
+    --test-signal it verifies a generated stereo input of that many seconds
+    instead of a file (CTest runs it this way, in a few configurations).
+
+    --stream reads raw interleaved little-endian PCM from stdin and writes the
+    same format to stdout, block by block through OxideAudioProcessor (so a
+    saved plugin state, morph slots included, sounds as it does in the DAW).
+    A reader thread fills one of two blocks while the other is processed, so
+    memory stays at two blocks whatever the stream length. The output is the
+    same length as the input with the plugin's latency removed.
+    Messages go to stderr.
+
+    --state-stress runs OxideAudioProcessor on an audio thread while other
+    threads save and load its state as fast as they can, the way host autosave
+    and session recall do during playback. It fails if any saved state mixes
+    values from two loads or the processor's state lock was ever taken on the
+    audio thread. Blocks over their real-time budget are reported, but only
+    fail the run with --strict-timing: on a loaded machine (a CI runner) the
+    scheduler alone can cause them, so use it with a few cores free.
+
+    --state-bench times saving and loading one instance's state (including
+    landing the load on the parameters), and loading the old XML format for
+    comparison. Multiply by the instance count for a session's save/load time.
+
+    --bench renders a generated signal (a tone over noise) through OxideDsp
+    directly, in float, double or both (the default), and reports the time
+    spent in process() as a share of real time. With both, the last line is
+    what the double path costs relative to float. --engines instead times the
+    same settings with the static saturation curve and with the hysteresis
+    engine (in a tape mode) and fails if hysteresis costs more than
+    kHysteresisBudgetPercent of one core on top of the curve.
+
+    --instances runs n OxideAudioProcessors side by side the way a host does,
+    each block going through every instance in turn, each with its own buffer,
+    and reports the time per block against the budget. Its working set is many
+    times the cache, so it's the one to wrap in perf stat for cache behaviour:
+
+        perf stat -e cycles,instructions,cache-references,cache-misses,L1-dcache-load-misses,LLC-load-misses \
+            OxideRender --instances 256 --seconds 20
+
+    To measure the lane-state packing, run that against a second build
+    configured with -DOXIDE_PACK_LANE_STATE=OFF (everything else the same).
+
+    --check-extremes renders every mode, crush mode and saturation engine with
+    the degradation controls at their top end (which Age then scales up to
+    three times further), in float and double, and fails if the output isn't
+    finite or peaks above kExtremePeakLimitDb. Run by CTest.
+*/
+
+#include "OxideDsp.h"
+#include "PluginProcessor.h"
+#include "PresetBank.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#if JUCE_WINDOWS
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace
+{
+    constexpr juce::int64 kEpochLength = 65536;   // samples between reseeds
+    constexpr int kBlockSize = 512;               // divides kEpochLength, so every render sees the same blocks
+    constexpr int kEpochsPerChunk = 16;
+    constexpr double kWarmupSeconds = 4.0;        // overlap rendered and discarded before each chunk
+    constexpr float kVerifyToleranceDb = -96.0f;
+    constexpr float kExtremePeakLimitDb = 24.0f;  // full-scale noise from a bad quantiser is ~+54 dBFS
+    constexpr double kHysteresisBudgetPercent = 2.0; // of one core, per stereo instance at 48 kHz
+
+    struct RenderSettings
+    {
+        juce::File input;
+        OxideDsp<float>::BlockSettings block;
+        juce::uint64 seed = 0;
+        double sampleRate = 44100.0;
+        int numChannels = 2;
+        juce::int64 length = 0;
+    };
+
+    std::unique_ptr<juce::AudioFormatReader> openReader(const juce::File& file)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+    }
+
+    // Renders [start, end) into output, beginning at warmupStart (epoch aligned)
+    // and discarding everything before start. The DSP's latency is removed by
+    // running on past the end (the reader pads with silence) and shifting back.
+    void renderRange(const RenderSettings& settings, juce::AudioFormatReader& reader,
+                     juce::int64 warmupStart, juce::int64 start, juce::int64 end,
+                     juce::AudioBuffer<float>& output)
+    {
+        OxideDsp<float> dsp;
+        dsp.prepare(settings.sampleRate, kBlockSize, settings.numChannels, settings.block.params);
+
+        const juce::int64 latency = OxideDsp<float>::getLatencySamples();
+        juce::AudioBuffer<float> block(settings.numChannels, kBlockSize);
+
+        for (auto position = warmupStart; position < end + latency;)
+        {
+            const auto epochOffset = position % kEpochLength;
+            if (epochOffset == 0)
+                dsp.beginEpoch(settings.seed, position);
+
+            const auto length = static_cast<int>(juce::jmin<juce::int64>(kBlockSize, end + latency - position, kEpochLength - epochOffset));
+
+            block.setSize(settings.numChannels, length, false, false, true);
+            reader.read(&block, 0, length, position, true, true);
+            dsp.process(block, settings.block);
+
+            // This block's output belongs `latency` samples earlier in the file
+            const auto outputStart = position - latency;
+            const auto first = juce::jmax(outputStart, start);
+            const auto last = juce::jmin(outputStart + length, end);
+
+            if (first < last)
+                for (int ch = 0; ch < settings.numChannels; ++ch)
+                    output.copyFrom(ch, static_cast<int>(first - start), block, ch,
+                                    static_cast<int>(first - outputStart), static_cast<int>(last - first));
+
+            position += length;
+        }
+    }
+
+    // Renders the whole file in chunks on a thread pool, handing each finished
+    // chunk to `consume` in order
+    bool renderChunked(const RenderSettings& settings, int numThreads,
+                       const std::function<void(const juce::AudioBuffer<float>&)>& consume)
+    {
+        const juce::int64 chunkLength = kEpochLength * kEpochsPerChunk;
+        const juce::int64 warmupLength = kEpochLength
+            * static_cast<juce::int64>(std::ceil(kWarmupSeconds * settings.sampleRate / static_cast<double>(kEpochLength)));
+        const int numChunks = static_cast<int>((settings.length + chunkLength - 1) / chunkLength);
+
+        struct Chunk
+        {
+            juce::AudioBuffer<float> output;
+            juce::WaitableEvent done;
+            std::atomic<bool> failed { false };
+        };
+
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        for (int c = 0; c < numChunks; ++c)
+            chunks.push_back(std::make_unique<Chunk>());
+
+        juce::ThreadPool pool(juce::ThreadPoolOptions {}.withNumberOfThreads(numThreads));
+        int submitted = 0;
+
+        const auto submit = [&](int c)
+        {
+            pool.addJob([&settings, &chunk = *chunks[static_cast<size_t>(c)], c, chunkLength, warmupLength]
+            {
+                const juce::int64 start = c * chunkLength;
+                const juce::int64 end = juce::jmin(settings.length, start + chunkLength);
+
+                if (auto reader = openReader(settings.input))
+                {
+                    chunk.output.setSize(settings.numChannels, static_cast<int>(end - start));
+                    renderRange(settings, *reader, juce::jmax(juce::int64 { 0 }, start - warmupLength), start, end, chunk.output);
+                }
+                else
+                {
+                    chunk.failed = true;
+                }
+
+                chunk.done.signal();
+            });
+        };
+
+        bool ok = true;
+
+        for (int c = 0; c < numChunks; ++c)
+        {
+            // Keep a couple of chunks per thread queued ahead of the writer, no more
+            while (submitted < numChunks && submitted < c + 2 * numThreads)
+                submit(submitted++);
+
+            auto& chunk = *chunks[static_cast<size_t>(c)];
+            chunk.done.wait();
+
+            if (chunk.failed)
+            {
+                ok = false;
+                continue;
+            }
+
+            consume(chunk.output);
+            chunk.output.setSize(0, 0);
+
+            std::cout << "\rRendered " << (c + 1) << "/" << numChunks << " chunks" << std::flush;
+        }
+
+        std::cout << std::endl;
+        return ok;
+    }
+
+    bool applyPreset(const juce::String& nameOrIndex, ParameterSnapshot& params)
+    {
+        const PresetBank bank;
+        const auto presets = bank.getPresets();
+
+        for (int i = 0; i < static_cast<int>(presets->size()); ++i)
+        {
+            const auto& preset = (*presets)[static_cast<size_t>(i)];
+            if (preset.name.equalsIgnoreCase(nameOrIndex)
+                || (nameOrIndex.containsOnly("0123456789") && nameOrIndex.getIntValue() == i))
+            {
+                params = preset.snapshot;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool applyOverride(const juce::String& assignment, ParameterSnapshot& params)
+    {
+        const auto id = assignment.upToFirstOccurrenceOf("=", false, false).trim();
+        const int index = findParameterIndex(hashParameterID(id.toRawUTF8()));
+        if (index < 0 || ! assignment.contains("="))
+            return false;
+
+        params[index] = assignment.fromFirstOccurrenceOf("=", false, false).getFloatValue();
+        return true;
+    }
+
+    // --preset, then each --set, on top of params. Returns an error message, or empty.
+    juce::String applyParameterArguments(const juce::ArgumentList& args, ParameterSnapshot& params)
+    {
+        if (args.containsOption("--preset") && ! applyPreset(args.getValueForOption("--preset"), params))
+            return "Unknown preset " + args.getValueForOption("--preset");
+
+        for (int i = 0; i + 1 < args.size(); ++i)
+            if (args[i] == "--set" && ! applyOverride(args[i + 1].text, params))
+                return "Bad parameter assignment " + args[i + 1].text;
+
+        return {};
+    }
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+
+    // === Streaming ===
+    enum class SampleFormat { f32, s16 };
+
+    struct StreamSettings
+    {
+        double sampleRate = 48000.0;
+        int numChannels = 2;
+        int blockSize = 512;
+        SampleFormat format = SampleFormat::f32;
+
+        int getFrameBytes() const noexcept { return numChannels * (format == SampleFormat::f32 ? 4 : 2); }
+    };
+
+    // Reads stdin on its own thread into two fixed blocks. The reader fills one
+    // while the processing side works on the other; neither ever grows.
+    class StdinReader : private juce::Thread
+    {
+    public:
+        explicit StdinReader(size_t blockBytes)
+            : juce::Thread("OxideRender stdin")
+        {
+            for (auto& slot : slots)
+            {
+                slot.data.resize(blockBytes);
+                slot.emptied.signal();
+            }
+
+            startThread();
+        }
+
+        ~StdinReader() override
+        {
+            // Only blocks if we bail out before the end of the input
+            signalThreadShouldExit();
+            for (auto& slot : slots)
+                slot.emptied.signal();
+            stopThread(1000);
+        }
+
+        struct Slot
+        {
+            std::vector<char> data;
+            size_t numBytes = 0;
+            juce::WaitableEvent filled;
+            juce::WaitableEvent emptied;
+        };
+
+        /** Waits for the next block; a short block (numBytes < size) is the last one. */
+        const Slot& acquire()
+        {
+            auto& slot = slots[static_cast<size_t>(consumeIndex)];
+            slot.filled.wait();
+            return slot;
+        }
+
+        void release()
+        {
+            slots[static_cast<size_t>(consumeIndex)].emptied.signal();
+            consumeIndex ^= 1;
+        }
+
+    private:
+        void run() override
+        {
+            for (size_t index = 0; ! threadShouldExit(); index ^= 1)
+            {
+                auto& slot = slots[index];
+                slot.emptied.wait();
+
+                if (threadShouldExit())
+                    return;
+
+                slot.numBytes = std::fread(slot.data.data(), 1, slot.data.size(), stdin);
+                slot.filled.signal();
+
+                if (slot.numBytes < slot.data.size())
+                    return;     // end of input (or a read error)
+            }
+        }
+
+        std::array<Slot, 2> slots;
+        int consumeIndex = 0;
+    };
+
+    void deinterleave(const char* data, SampleFormat format, juce::AudioBuffer<float>& buffer)
+    {
+        const int numChannels = buffer.getNumChannels();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* dest = buffer.getWritePointer(ch);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const auto index = static_cast<size_t>(i * numChannels + ch);
+
+                if (format == SampleFormat::f32)
+                {
+                    juce::uint32 bits;
+                    std::memcpy(&bits, data + index * 4, 4);
+                    bits = juce::ByteOrder::swapIfBigEndian(bits);
+                    std::memcpy(dest + i, &bits, 4);
+                }
+                else
+                {
+                    juce::uint16 bits;
+                    std::memcpy(&bits, data + index * 2, 2);
+                    dest[i] = static_cast<float>(static_cast<juce::int16>(juce::ByteOrder::swapIfBigEndian(bits))) / 32768.0f;
+                }
+            }
+        }
+    }
+
+    void interleave(const juce::AudioBuffer<float>& buffer, int start, int numFrames, SampleFormat format, char* data)
+    {
+        const int numChannels = buffer.getNumChannels();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* source = buffer.getReadPointer(ch, start);
+
+            for (int i = 0; i < numFrames; ++i)
+            {
+                const auto index = static_cast<size_t>(i * numChannels + ch);
+
+                if (format == SampleFormat::f32)
+                {
+                    juce::uint32 bits;
+                    std::memcpy(&bits, source + i, 4);
+                    bits = juce::ByteOrder::swapIfBigEndian(bits);
+                    std::memcpy(data + index * 4, &bits, 4);
+                }
+                else
+                {
+                    const auto value = static_cast<juce::int16>(juce::roundToInt(juce::jlimit(-1.0f, 1.0f, source[i]) * 32767.0f));
+                    const auto bits = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint16>(value));
+                    std::memcpy(data + index * 2, &bits, 2);
+                }
+            }
+        }
+    }
+
+    int runStream(const juce::ArgumentList& args)
+    {
+        // The processor's parameter tree wants a message manager, even with no UI
+        juce::ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        StreamSettings stream;
+        if (args.containsOption("--rate"))
+            stream.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+        if (args.containsOption("--channels"))
+            stream.numChannels = args.getValueForOption("--channels").getIntValue();
+        if (args.containsOption("--block"))
+            stream.blockSize = args.getValueForOption("--block").getIntValue();
+
+        if (args.containsOption("--format"))
+        {
+            const auto format = args.getValueForOption("--format");
+            if (format == "s16")
+                stream.format = SampleFormat::s16;
+            else if (format != "f32")
+                return fail("Unsupported format " + format + " (use f32 or s16)");
+        }
+
+        if (stream.sampleRate < 8000.0 || stream.numChannels < 1 || stream.blockSize < 16)
+            return fail("Bad stream settings");
+
+        OxideAudioProcessor processor;
+
+        const auto channelSet = juce::AudioChannelSet::canonicalChannelSet(stream.numChannels);
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(channelSet);
+        layout.outputBuses.add(channelSet);
+        if (! processor.setBusesLayout(layout))
+            return fail("Unsupported channel count " + juce::String(stream.numChannels));
+
+        // Parameters: saved plugin state, then a preset, then individual overrides
+        if (args.containsOption("--state"))
+        {
+            juce::MemoryBlock state;
+            if (! args.getFileForOption("--state").loadFileAsData(state))
+                return fail("Can't read " + args.getValueForOption("--state"));
+
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        }
+
+        auto params = ParameterSnapshot::capture(processor.getAPVTS());
+
+        if (const auto error = applyParameterArguments(args, params); error.isNotEmpty())
+            return fail(error);
+
+        params.applyTo(processor.getAPVTS());
+
+        processor.setNonRealtime(true);
+        processor.setRateAndBufferSizeDetails(stream.sampleRate, stream.blockSize);
+        processor.prepareToPlay(stream.sampleRate, stream.blockSize);
+
+#if JUCE_WINDOWS
+        _setmode(_fileno(stdin), _O_BINARY);
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+        const auto frameBytes = static_cast<size_t>(stream.getFrameBytes());
+        const auto blockBytes = frameBytes * static_cast<size_t>(stream.blockSize);
+
+        juce::AudioBuffer<float> buffer(stream.numChannels, stream.blockSize);
+        juce::MidiBuffer midi;
+        std::vector<char> output(blockBytes);
+
+        // Output lags the input by the latency: drop that much at the start and
+        // run the same amount of silence through at the end
+        int toSkip = processor.getLatencySamples();
+        int toFlush = toSkip;
+        bool endOfInput = false;
+        juce::int64 framesWritten = 0;
+
+        StdinReader reader(blockBytes);
+
+        while (! endOfInput || toFlush > 0)
+        {
+            int numFrames = 0;
+
+            if (! endOfInput)
+            {
+                const auto& slot = reader.acquire();
+                numFrames = static_cast<int>(slot.numBytes / frameBytes);
+                endOfInput = slot.numBytes < blockBytes;
+
+                buffer.setSize(stream.numChannels, numFrames, false, false, true);
+                deinterleave(slot.data.data(), stream.format, buffer);
+                reader.release();
+            }
+            else
+            {
+                numFrames = juce::jmin(stream.blockSize, toFlush);
+                toFlush -= numFrames;
+
+                buffer.setSize(stream.numChannels, numFrames, false, false, true);
+                buffer.clear();
+            }
+
+            if (numFrames == 0)
+                continue;
+
+            processor.processBlock(buffer, midi);
+
+            const int skip = juce::jmin(toSkip, numFrames);
+            toSkip -= skip;
+
+            const auto numOut = static_cast<size_t>(numFrames - skip);
+            interleave(buffer, skip, numFrames - skip, stream.format, output.data());
+
+            if (std::fwrite(output.data(), frameBytes, numOut, stdout) != numOut)
+                return fail("Write to stdout failed");
+
+            framesWritten += static_cast<juce::int64>(numOut);
+        }
+
+        std::fflush(stdout);
+        processor.releaseResources();
+
+        std::cerr << "Streamed " << framesWritten << " frames" << std::endl;
+        return 0;
+    }
+
+    // === State stress ===
+    // The current values of a state this build saved (so its columns are in our order)
+    bool readSavedParameters(const juce::MemoryBlock& state, ParameterSnapshot& params)
+    {
+        juce::MemoryInputStream in(state, false);
+
+        const auto magic = static_cast<juce::uint32>(in.readInt());
+        in.skipNextBytes(12);   // version, frame rate, program
+        const int numColumns = in.readInt();
+
+        if (magic != 0x5453584f || numColumns != ParameterIDs::numParameters
+            || in.getNumBytesRemaining() < static_cast<juce::int64>(numColumns) * 8)
+            return false;
+
+        in.skipNextBytes(numColumns * 4);
+        for (auto& value : params.values)
+            value = in.readFloat();
+
+        return true;
+    }
+
+    bool matchesOneOf(const ParameterSnapshot& params, const std::vector<ParameterSnapshot>& candidates)
+    {
+        return std::any_of(candidates.begin(), candidates.end(), [&params](const ParameterSnapshot& candidate)
+        {
+            for (int i = 0; i < ParameterIDs::numParameters; ++i)
+                if (std::abs(params[i] - candidate[i]) > 1.0e-3f * juce::jmax(1.0f, std::abs(candidate[i])))
+                    return false;
+            return true;
+        });
+    }
+
+    int runStateStress(const juce::ArgumentList& args)
+    {
+        juce::ScopedJuceInitialiser_GUI libraryInitialiser;   // this thread is the message thread
+
+        const double seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 10.0;
+        const double sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+        const int blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+        if (seconds <= 0.0 || sampleRate < 8000.0 || blockSize < 16)
+            return fail("Bad stress settings");
+
+        OxideAudioProcessor processor;
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // One saved state per factory preset: every save has to come back as exactly one of them
+        std::vector<juce::MemoryBlock> states;
+        std::vector<ParameterSnapshot> loadable;
+
+        for (int i = 0; i < processor.getNumPrograms(); ++i)
+        {
+            processor.setCurrentProgram(i);
+            states.emplace_back();
+            processor.getStateInformation(states.back());
+            loadable.push_back(ParameterSnapshot::capture(processor.getAPVTS()));
+        }
+
+        struct BlockStats
+        {
+            juce::int64 numBlocks = 0;
+            juce::int64 numOverruns = 0;
+            double worstMs = 0.0;
+        };
+
+        const double budgetMs = 1000.0 * blockSize / sampleRate;
+        BlockStats quiet, stressed;                 // audio thread only until it's joined
+        std::atomic<bool> stressing { false };
+        std::atomic<bool> stop { false };
+
+        std::thread audio([&]
+        {
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midi;
+            juce::Random random;
+
+            while (! stop.load())
+            {
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    for (int i = 0; i < blockSize; ++i)
+                        buffer.setSample(ch, i, random.nextFloat() * 0.5f - 0.25f);
+
+                const bool underStress = stressing.load();
+                const auto startMs = juce::Time::getMillisecondCounterHiRes();
+                processor.processBlock(buffer, midi);
+                const auto elapsedMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+
+                auto& stats = underStress ? stressed : quiet;
+                ++stats.numBlocks;
+                stats.worstMs = juce::jmax(stats.worstMs, elapsedMs);
+                if (elapsedMs > budgetMs)
+                    ++stats.numOverruns;
+            }
+        });
+
+        // A second of undisturbed playback for comparison
+        juce::Thread::sleep(1000);
+        stressing = true;
+
+        std::atomic<juce::int64> numSaves { 0 }, numIncoherent { 0 }, numLoads { 0 };
+        std::vector<std::thread> traffic;
+
+        // Autosave: two host threads saving back to back
+        for (int t = 0; t < 2; ++t)
+        {
+            traffic.emplace_back([&]
+            {
+                juce::MemoryBlock saved;
+                ParameterSnapshot params;
+
+                while (! stop.load())
+                {
+                    saved.reset();
+                    processor.getStateInformation(saved);
+                    ++numSaves;
+
+                    if (! readSavedParameters(saved, params) || ! matchesOneOf(params, loadable))
+                        ++numIncoherent;
+                }
+            });
+        }
+
+        // Session recall from a host thread
+        traffic.emplace_back([&]
+        {
+            juce::Random random;
+
+            while (! stop.load())
+            {
+                const auto& state = states[static_cast<size_t>(random.nextInt(static_cast<int>(states.size())))];
+                processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+                ++numLoads;
+            }
+        });
+
+        // ... and from the message thread, which also lands the other thread's loads
+        juce::Random random;
+        const auto endMs = juce::Time::getMillisecondCounterHiRes() + seconds * 1000.0;
+
+        while (juce::Time::getMillisecondCounterHiRes() < endMs)
+        {
+            const auto& state = states[static_cast<size_t>(random.nextInt(static_cast<int>(states.size())))];
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+            ++numLoads;
+
+            processor.applyPendingState();
+            juce::Thread::sleep(1);
+        }
+
+        stop = true;
+        for (auto& thread : traffic)
+            thread.join();
+        audio.join();
+
+        processor.applyPendingState();
+        processor.releaseResources();
+
+        std::cout << "Blocks of " << blockSize << " (budget " << budgetMs << " ms)" << std::endl
+                  << "  quiet:            " << quiet.numBlocks << ", worst " << quiet.worstMs << " ms, "
+                  << quiet.numOverruns << " over budget" << std::endl
+                  << "  with state calls: " << stressed.numBlocks << ", worst " << stressed.worstMs << " ms, "
+                  << stressed.numOverruns << " over budget" << std::endl
+                  << "Saves: " << numSaves.load() << " (" << numIncoherent.load() << " incoherent), loads: "
+                  << numLoads.load() << std::endl;
+
+        if (numIncoherent.load() > 0)
+            return fail("FAILED: a saved state mixed values from different loads");
+
+        if (processor.getStateLockAudioThreadCount() > 0)
+            return fail("FAILED: the state lock was taken on the audio thread");
+
+        if (stressed.numOverruns > 0 && args.containsOption("--strict-timing"))
+            return fail("FAILED: blocks overran their budget while state was saved and loaded");
+
+        std::cout << "OK" << std::endl;
+        return 0;
+    }
+
+    // === State benchmark ===
+    int runStateBench(const juce::ArgumentList& args)
+    {
+        juce::ScopedJuceInitialiser_GUI libraryInitialiser;   // this thread is the message thread
+
+        const int iterations = args.containsOption("--iterations") ? args.getValueForOption("--iterations").getIntValue() : 2000;
+        if (iterations < 1)
+            return fail("Bad iteration count");
+
+        OxideAudioProcessor processor;
+        processor.setRateAndBufferSizeDetails(48000.0, 512);
+        processor.prepareToPlay(48000.0, 512);
+        processor.setCurrentProgram(juce::jmin(1, processor.getNumPrograms() - 1));
+
+        juce::MemoryBlock binary;
+        processor.getStateInformation(binary);
+
+        // What a version 1 session stored: the parameter tree as XML
+        juce::MemoryBlock legacy;
+        if (auto xml = processor.getAPVTS().copyState().createXml())
+            juce::AudioProcessor::copyXmlToBinary(*xml, legacy);
+
+        // Microseconds per call, best of three passes so a stray context switch doesn't count
+        const auto timePerCall = [iterations](const std::function<void()>& call)
+        {
+            double best = std::numeric_limits<double>::max();
+            for (int pass = 0; pass < 3; ++pass)
+            {
+                const auto startMs = juce::Time::getMillisecondCounterHiRes();
+                for (int i = 0; i < iterations; ++i)
+                    call();
+                best = juce::jmin(best, (juce::Time::getMillisecondCounterHiRes() - startMs) * 1000.0 / iterations);
+            }
+            return best;
+        };
+
+        juce::MemoryBlock saved;
+        const double saveUs = timePerCall([&]
+        {
+            saved.reset();
+            processor.getStateInformation(saved);
+        });
+
+        // Loads on the message thread land on the parameters before returning
+        const double loadUs = timePerCall([&]
+        {
+            processor.setStateInformation(binary.getData(), static_cast<int>(binary.getSize()));
+        });
+
+        const double legacyLoadUs = legacy.isEmpty() ? 0.0 : timePerCall([&]
+        {
+            processor.setStateInformation(legacy.getData(), static_cast<int>(legacy.getSize()));
+        });
+
+        processor.releaseResources();
+
+        std::cout << "State round trip, " << iterations << " iterations (best of 3), per instance:" << std::endl
+                  << "  save:            " << saveUs << " us (" << binary.getSize() << " bytes)" << std::endl
+                  << "  load:            " << loadUs << " us" << std::endl;
+
+        if (! legacy.isEmpty())
+            std::cout << "  load (XML, v1):  " << legacyLoadUs << " us (" << legacy.getSize() << " bytes)" << std::endl;
+
+        std::cout << "  save + load x 100 instances: " << (saveUs + loadUs) * 100.0 / 1000.0 << " ms" << std::endl;
+        return 0;
+    }
+
+    // === Generated input ===
+    // A 220 Hz tone at -12 dBFS over low noise, the same on every run; one
+    // second of it (a whole number of cycles) loops without a click
+    template <typename SampleType>
+    void fillTestSignal(juce::AudioBuffer<SampleType>& buffer, double sampleRate, juce::int64 startSample = 0)
+    {
+        const auto loopLength = static_cast<juce::int64>(sampleRate);
+        juce::Random random(startSample + 1);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const auto position = static_cast<double>((startSample + i) % loopLength);
+                buffer.setSample(ch, i, static_cast<SampleType>(
+                    0.25 * std::sin(juce::MathConstants<double>::twoPi * 220.0 * position / static_cast<double>(loopLength))
+                    + 0.05 * (random.nextDouble() * 2.0 - 1.0)));
+            }
+    }
+
+    // Writes the generated signal to a 32-bit float stereo WAV, for --test-signal
+    bool writeTestSignal(const juce::File& file, double seconds, double sampleRate)
+    {
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        if (stream->failedToOpen())
+            return false;
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 32, {}, 0));
+        if (writer == nullptr)
+            return false;
+
+        stream.release();   // owned by the writer now
+
+        const auto length = static_cast<juce::int64>(seconds * sampleRate);
+        juce::AudioBuffer<float> block(2, kBlockSize);
+
+        for (juce::int64 position = 0; position < length; position += kBlockSize)
+        {
+            const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(kBlockSize, length - position));
+            block.setSize(2, numSamples, false, false, true);
+            fillTestSignal(block, sampleRate, position);
+
+            if (! writer->writeFromAudioSampleBuffer(block, 0, numSamples))
+                return false;
+        }
+
+        return true;
+    }
+
+    // === DSP benchmark ===
+    struct BenchSettings
+    {
+        ParameterSnapshot params;
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numChannels = 2;
+        double seconds = 30.0;
+    };
+
+    struct BenchResult
+    {
+        double processSeconds = 0.0;    // inside process(), all blocks
+        double worstBlockMs = 0.0;
+    };
+
+    // Renders bench.seconds of signal through OxideDsp<SampleType>, timing process() alone
+    template <typename SampleType>
+    BenchResult runDspBench(const BenchSettings& bench)
+    {
+        typename OxideDsp<SampleType>::BlockSettings block;
+        block.params = bench.params;
+        block.params[ParameterIDs::Index::morphOn] = 0.0f;
+        block.modeA = block.modeB = juce::jlimit(0, 3, static_cast<int>(block.params[ParameterIDs::Index::mode]));
+
+        OxideDsp<SampleType> dsp;
+        dsp.prepare(bench.sampleRate, bench.blockSize, bench.numChannels, block.params);
+
+        // One second of input, looped
+        const int loopLength = static_cast<int>(bench.sampleRate);
+        juce::AudioBuffer<SampleType> input(bench.numChannels, loopLength);
+        fillTestSignal(input, bench.sampleRate);
+
+        const auto totalSamples = static_cast<juce::int64>(bench.seconds * bench.sampleRate);
+        juce::AudioBuffer<SampleType> buffer(bench.numChannels, bench.blockSize);
+        BenchResult result;
+        juce::int64 totalTicks = 0;
+        int loopPosition = 0;
+
+        for (juce::int64 position = 0; position < totalSamples;)
+        {
+            const auto length = static_cast<int>(juce::jmin<juce::int64>(bench.blockSize, totalSamples - position, loopLength - loopPosition));
+
+            buffer.setSize(bench.numChannels, length, false, false, true);
+            for (int ch = 0; ch < bench.numChannels; ++ch)
+                buffer.copyFrom(ch, 0, input, ch, loopPosition, length);
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            dsp.process(buffer, block);
+            const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+
+            totalTicks += elapsedTicks;
+            result.worstBlockMs = juce::jmax(result.worstBlockMs, 1000.0 * juce::Time::highResolutionTicksToSeconds(elapsedTicks));
+
+            loopPosition = (loopPosition + length) % loopLength;
+            position += length;
+        }
+
+        result.processSeconds = juce::Time::highResolutionTicksToSeconds(totalTicks);
+        return result;
+    }
+
+    void printBenchResult(const char* label, const BenchSettings& bench, const BenchResult& result)
+    {
+        const double budgetMs = 1000.0 * bench.blockSize / bench.sampleRate;
+
+        std::cout << "  " << label << ": " << result.processSeconds * 1000.0 << " ms for " << bench.seconds << " s, "
+                  << 100.0 * result.processSeconds / bench.seconds << "% of one core, "
+                  << bench.seconds / juce::jmax(1.0e-9, result.processSeconds) << "x real time, worst block "
+                  << result.worstBlockMs << " ms (budget " << budgetMs << " ms)" << std::endl;
+    }
+
+    // Curve vs hysteresis saturation at the same settings, against the engine's CPU budget
+    template <typename SampleType>
+    int runEngineBench(BenchSettings bench, const char* label)
+    {
+        const int mode = static_cast<int>(bench.params[ParameterIDs::Index::mode]);
+        if (mode != 0 && mode != 2)
+            bench.params[ParameterIDs::Index::mode] = 0.0f;   // hysteresis only runs in Cassette and VHS
+
+        std::cout << "Saturation engines (" << label << "), " << bench.numChannels << " channels at "
+                  << bench.sampleRate << " Hz, blocks of " << bench.blockSize << ":" << std::endl;
+
+        bench.params[ParameterIDs::Index::satEngine] = 0.0f;
+        const auto curve = runDspBench<SampleType>(bench);
+        printBenchResult("curve     ", bench, curve);
+
+        bench.params[ParameterIDs::Index::satEngine] = 1.0f;
+        const auto hysteresis = runDspBench<SampleType>(bench);
+        printBenchResult("hysteresis", bench, hysteresis);
+
+        const double addedPercent = 100.0 * (hysteresis.processSeconds - curve.processSeconds) / bench.seconds;
+        std::cout << "  hysteresis adds " << addedPercent << "% of one core (budget " << kHysteresisBudgetPercent
+                  << "% per stereo instance at 48 kHz)" << std::endl;
+
+        if (addedPercent > kHysteresisBudgetPercent)
+            return fail("OVER BUDGET: hysteresis engine");
+
+        std::cout << "OK" << std::endl;
+        return 0;
+    }
+
+    int runBench(const juce::ArgumentList& args)
+    {
+        BenchSettings bench;
+        bench.params = PresetBank::getDefaultSnapshot();
+
+        if (args.containsOption("--seconds"))
+            bench.seconds = args.getValueForOption("--seconds").getDoubleValue();
+        if (args.containsOption("--rate"))
+            bench.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+        if (args.containsOption("--block"))
+            bench.blockSize = args.getValueForOption("--block").getIntValue();
+        if (args.containsOption("--channels"))
+            bench.numChannels = args.getValueForOption("--channels").getIntValue();
+
+        if (bench.seconds <= 0.0 || bench.sampleRate < 8000.0 || bench.blockSize < 16 || bench.numChannels < 1)
+            return fail("Bad benchmark settings");
+
+        if (const auto error = applyParameterArguments(args, bench.params); error.isNotEmpty())
+            return fail(error);
+
+        const auto precision = args.containsOption("--precision") ? args.getValueForOption("--precision") : juce::String("both");
+        if (precision != "float" && precision != "double" && precision != "both")
+            return fail("Unsupported precision " + precision + " (use float or double)");
+
+        if (args.containsOption("--engines"))
+            return precision == "double" ? runEngineBench<double>(bench, "double") : runEngineBench<float>(bench, "float");
+
+        std::cout << "OxideDsp, " << bench.numChannels << " channels at " << bench.sampleRate << " Hz, blocks of "
+                  << bench.blockSize << ":" << std::endl;
+
+        BenchResult single, twice;
+
+        if (precision != "double")
+        {
+            single = runDspBench<float>(bench);
+            printBenchResult("float ", bench, single);
+        }
+
+        if (precision != "float")
+        {
+            twice = runDspBench<double>(bench);
+            printBenchResult("double", bench, twice);
+        }
+
+        if (precision == "both")
+            std::cout << "  double / float: " << twice.processSeconds / juce::jmax(1.0e-9, single.processSeconds) << std::endl;
+
+        return 0;
+    }
+
+    // === Many-instance benchmark ===
+    int runInstanceBench(const juce::ArgumentList& args)
+    {
+        juce::ScopedJuceInitialiser_GUI libraryInitialiser;   // the processors' parameter trees want one
+
+        const int numInstances = args.getValueForOption("--instances").getIntValue();
+        const double seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 20.0;
+        const double sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+        const int blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 256;
+
+        if (numInstances < 1 || seconds <= 0.0 || sampleRate < 8000.0 || blockSize < 16)
+            return fail("Bad instance benchmark settings");
+
+        auto params = PresetBank::getDefaultSnapshot();
+        if (const auto error = applyParameterArguments(args, params); error.isNotEmpty())
+            return fail(error);
+
+        struct Instance
+        {
+            OxideAudioProcessor processor;
+            juce::AudioBuffer<float> buffer;
+        };
+
+        std::vector<std::unique_ptr<Instance>> instances;
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            auto instance = std::make_unique<Instance>();
+            params.applyTo(instance->processor.getAPVTS());
+            instance->processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            instance->processor.prepareToPlay(sampleRate, blockSize);
+            instance->buffer.setSize(2, blockSize);
+            instances.push_back(std::move(instance));
+        }
+
+        // One second of input, looped; every track plays it from its own buffer
+        const int loopLength = static_cast<int>(sampleRate);
+        juce::AudioBuffer<float> input(2, loopLength);
+        fillTestSignal(input, sampleRate);
+
+        const auto numBlocks = static_cast<juce::int64>(seconds * sampleRate) / blockSize;
+        juce::MidiBuffer midi;
+        juce::int64 totalTicks = 0;
+        double worstBlockMs = 0.0;
+        int loopPosition = 0;
+
+        for (juce::int64 b = 0; b < numBlocks; ++b)
+        {
+            const int length = juce::jmin(blockSize, loopLength - loopPosition);
+            juce::int64 blockTicks = 0;
+
+            for (auto& instance : instances)
+            {
+                instance->buffer.setSize(2, length, false, false, true);
+                for (int ch = 0; ch < 2; ++ch)
+                    instance->buffer.copyFrom(ch, 0, input, ch, loopPosition, length);
+
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+                instance->processor.processBlock(instance->buffer, midi);
+                blockTicks += juce::Time::getHighResolutionTicks() - startTicks;
+            }
+
+            totalTicks += blockTicks;
+            worstBlockMs = juce::jmax(worstBlockMs, 1000.0 * juce::Time::highResolutionTicksToSeconds(blockTicks));
+            loopPosition = (loopPosition + length) % loopLength;
+        }
+
+        for (auto& instance : instances)
+            instance->processor.releaseResources();
+
+        const double processSeconds = juce::Time::highResolutionTicksToSeconds(totalTicks);
+        const double renderedSeconds = static_cast<double>(numBlocks * blockSize) / sampleRate;
+        const double budgetMs = 1000.0 * blockSize / sampleRate;
+
+        std::cout << numInstances << " instances, stereo at " << sampleRate << " Hz, blocks of " << blockSize << ":" << std::endl
+                  << "  " << processSeconds * 1000.0 << " ms for " << renderedSeconds << " s, "
+                  << 100.0 * processSeconds / renderedSeconds << "% of one core ("
+                  << 100.0 * processSeconds / renderedSeconds / numInstances << "% per instance)" << std::endl
+                  << "  per block, all instances: mean " << 1000.0 * processSeconds / static_cast<double>(juce::jmax<juce::int64>(1, numBlocks))
+                  << " ms, worst " << worstBlockMs << " ms (budget " << budgetMs << " ms)" << std::endl;
+        return 0;
+    }
+
+    // === Extreme settings check ===
+    // Peak output over a few seconds of generated input (infinity if anything isn't finite)
+    template <typename SampleType>
+    float renderPeak(const ParameterSnapshot& params, double sampleRate, double seconds)
+    {
+        typename OxideDsp<SampleType>::BlockSettings block;
+        block.params = params;
+        block.modeA = block.modeB = juce::jlimit(0, 3, static_cast<int>(params[ParameterIDs::Index::mode]));
+
+        OxideDsp<SampleType> dsp;
+        dsp.prepare(sampleRate, kBlockSize, 2, params);
+
+        juce::AudioBuffer<SampleType> buffer(2, kBlockSize);
+        const auto totalSamples = static_cast<juce::int64>(seconds * sampleRate);
+        float peak = 0.0f;
+
+        for (juce::int64 position = 0; position < totalSamples; position += kBlockSize)
+        {
+            fillTestSignal(buffer, sampleRate, position);
+            dsp.process(buffer, block);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < kBlockSize; ++i)
+                {
+                    const auto sample = buffer.getSample(ch, i);
+                    if (! std::isfinite(sample))
+                        return std::numeric_limits<float>::infinity();
+                    peak = juce::jmax(peak, static_cast<float>(std::abs(sample)));
+                }
+        }
+
+        return peak;
+    }
+
+    int runExtremesCheck()
+    {
+        using namespace ParameterIDs;
+
+        auto params = PresetBank::getDefaultSnapshot();
+        params[Index::bitcrush] = Ranges::bitcrushMax;
+        params[Index::downsample] = Ranges::downsampleMax;
+        params[Index::noise] = Ranges::noiseMax;
+        params[Index::crackle] = Ranges::crackleMax;
+        params[Index::wobble] = Ranges::wobbleMax;
+        params[Index::dropout] = Ranges::dropoutMax;
+        params[Index::saturation] = Ranges::saturationMax;
+        params[Index::age] = Ranges::ageMax;
+        params[Index::filterRes] = Ranges::filterResMax;
+        params[Index::filterDrive] = Ranges::filterDriveMax;
+        params[Index::mix] = Ranges::mixMax;
+        params[Index::output] = 0.0f;
+        params[Index::morphOn] = 0.0f;
+
+        constexpr double sampleRate = 48000.0;
+        constexpr double seconds = 2.0;
+        bool ok = true;
+
+        for (int mode = 0; mode < 4; ++mode)
+            for (int crushMode = 0; crushMode < 2; ++crushMode)
+                for (int satEngine = 0; satEngine < 2; ++satEngine)
+                {
+                    params[Index::mode] = static_cast<float>(mode);
+                    params[Index::crushMode] = static_cast<float>(crushMode);
+                    params[Index::satEngine] = static_cast<float>(satEngine);
+
+                    const std::pair<const char*, float> peaks[] = {
+                        { "float ", renderPeak<float>(params, sampleRate, seconds) },
+                        { "double", renderPeak<double>(params, sampleRate, seconds) },
+                    };
+
+                    for (const auto& [precision, peak] : peaks)
+                    {
+                        const float peakDb = juce::Decibels::gainToDecibels(peak, -200.0f);
+                        const bool inRange = std::isfinite(peak) && peakDb <= kExtremePeakLimitDb;
+                        ok = ok && inRange;
+
+                        std::cout << "mode " << mode << ", " << (crushMode != 0 ? "clean" : "raw  ") << " crush, engine "
+                                  << satEngine << ", " << precision << ": " << peakDb << " dBFS"
+                                  << (inRange ? "" : "  <-- out of range") << std::endl;
+                    }
+                }
+
+        if (! ok)
+            return fail("FAILED: output out of range at extreme settings");
+
+        std::cout << "OK" << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--stream"))
+        return runStream(args);
+
+    if (args.containsOption("--state-stress"))
+        return runStateStress(args);
+
+    if (args.containsOption("--state-bench"))
+        return runStateBench(args);
+
+    if (args.containsOption("--bench"))
+        return runBench(args);
+
+    if (args.containsOption("--check-extremes"))
+        return runExtremesCheck();
+
+    if (args.containsOption("--instances"))
+        return runInstanceBench(args);
+
+    // --verify on a generated input (no files needed, so CTest can run it anywhere)
+    std::unique_ptr<juce::TemporaryFile> generatedInput;
+
+    if (args.containsOption("--test-signal"))
+    {
+        const double seconds = args.getValueForOption("--test-signal").getDoubleValue();
+        if (! args.containsOption("--verify") || seconds <= 0.0)
+            return fail("--test-signal <seconds> only works with --verify");
+
+        generatedInput = std::make_unique<juce::TemporaryFile>(".wav");
+        if (! writeTestSignal(generatedInput->getFile(), seconds, 48000.0))
+            return fail("Can't write the test signal to " + generatedInput->getFile().getFullPathName());
+    }
+    else if (args.size() < 2)
+        return fail("usage: OxideRender <input> <output.wav> [--preset <index|name>] [--set <id>=<value>]... "
+                    "[--threads <n>] [--seed <n>] [--verify]\n"
+                    "       OxideRender --verify --test-signal <seconds> [--preset <index|name>] [--set <id>=<value>]... "
+                    "[--threads <n>] [--seed <n>]\n"
+                    "       OxideRender --stream [--rate <hz>] [--channels <n>] [--format f32|s16] [--block <frames>] "
+                    "[--state <file>] [--preset <index|name>] [--set <id>=<value>]...\n"
+                    "       OxideRender --state-stress [--seconds <n>] [--rate <hz>] [--block <frames>] [--strict-timing]\n"
+                    "       OxideRender --state-bench [--iterations <n>]\n"
+                    "       OxideRender --bench [--precision float|double] [--engines] [--seconds <n>] [--rate <hz>] [--block <frames>] "
+                    "[--channels <n>] [--preset <index|name>] [--set <id>=<value>]...\n"
+                    "       OxideRender --instances <n> [--seconds <n>] [--rate <hz>] [--block <frames>] "
+                    "[--preset <index|name>] [--set <id>=<value>]...\n"
+                    "       OxideRender --check-extremes");
+
+    RenderSettings settings;
+    settings.input = generatedInput != nullptr ? generatedInput->getFile() : args[0].resolveAsFile();
+    const auto outputFile = generatedInput != nullptr ? juce::File() : args[1].resolveAsFile();
+
+    auto reader = openReader(settings.input);
+    if (reader == nullptr)
+        return fail("Can't read " + settings.input.getFullPathName());
+
+    settings.sampleRate = reader->sampleRate;
+    settings.numChannels = static_cast<int>(reader->numChannels);
+    settings.length = reader->lengthInSamples;
+
+    // Parameters: defaults, then a preset, then individual overrides
+    auto& params = settings.block.params;
+    params = PresetBank::getDefaultSnapshot();
+
+    if (const auto error = applyParameterArguments(args, params); error.isNotEmpty())
+        return fail(error);
+
+    settings.block.modeA = settings.block.modeB = juce::jlimit(0, 3, static_cast<int>(params[ParameterIDs::Index::mode]));
+    settings.block.params[ParameterIDs::Index::morphOn] = 0.0f;
+
+    settings.seed = args.containsOption("--seed")
+        ? static_cast<juce::uint64>(args.getValueForOption("--seed").getLargeIntValue())
+        : static_cast<juce::uint64>(juce::Random::getSystemRandom().nextInt64());
+
+    const int numThreads = args.containsOption("--threads")
+        ? juce::jmax(1, args.getValueForOption("--threads").getIntValue())
+        : juce::jmax(1, juce::SystemStats::getNumCpus());
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    if (args.containsOption("--verify"))
+    {
+        // Chunked render into memory, then the same file start to finish on this thread
+        juce::AudioBuffer<float> chunked(settings.numChannels, static_cast<int>(settings.length));
+        int writePosition = 0;
+
+        if (! renderChunked(settings, numThreads, [&](const juce::AudioBuffer<float>& chunk)
+            {
+                for (int ch = 0; ch < settings.numChannels; ++ch)
+                    chunked.copyFrom(ch, writePosition, chunk, ch, 0, chunk.getNumSamples());
+                writePosition += chunk.getNumSamples();
+            }))
+            return fail("Chunked render failed");
+
+        juce::AudioBuffer<float> serial(settings.numChannels, static_cast<int>(settings.length));
+        renderRange(settings, *reader, 0, 0, settings.length, serial);
+
+        float maxDifference = 0.0f;
+        for (int ch = 0; ch < settings.numChannels; ++ch)
+        {
+            const auto* a = chunked.getReadPointer(ch);
+            const auto* b = serial.getReadPointer(ch);
+            for (int i = 0; i < chunked.getNumSamples(); ++i)
+                maxDifference = juce::jmax(maxDifference, std::abs(a[i] - b[i]));
+        }
+
+        const float differenceDb = juce::Decibels::gainToDecibels(maxDifference, -200.0f);
+        std::cout << "Max difference, chunked vs serial: " << differenceDb << " dBFS" << std::endl;
+
+        if (differenceDb > kVerifyToleranceDb)
+            return fail("FAILED: chunked render differs from serial render");
+
+        std::cout << "OK" << std::endl;
+        return 0;
+    }
+
+    outputFile.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(outputFile);
+    if (stream->failedToOpen())
+        return fail("Can't write " + outputFile.getFullPathName());
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), settings.sampleRate,
+                                                                        static_cast<unsigned int>(settings.numChannels),
+                                                                        juce::jmax(16, static_cast<int>(reader->bitsPerSample)),
+                                                                        {}, 0));
+    if (writer == nullptr)
+        return fail("Can't create a WAV writer for " + outputFile.getFullPathName());
+
+    stream.release();   // owned by the writer now
+
+    if (! renderChunked(settings, numThreads, [&](const juce::AudioBuffer<float>& chunk)
+        {
+            writer->writeFromAudioSampleBuffer(chunk, 0, chunk.getNumSamples());
+        }))
+        return fail("Render failed");
+
+    writer.reset();
+
+    const auto seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    std::cout << "Rendered " << settings.input.getFileName() << " -> " << outputFile.getFileName()
+              << " in " << seconds << " s on " << numThreads << " threads (seed " << settings.seed << ")" << std::endl;
+    return 0;
+}
@@ -27,6 +27,63 @@ namespace ParameterIDs
     inline constexpr const char* output       = "output";       // Output gain (-24 to +12 dB)
     inline constexpr const char* bypass       = "bypass";       // Master bypass
 
+    // === MORPH ===
+    inline constexpr const char* morph        = "morph";        // A/B morph position (0-100%)
+    inline constexpr const char* morphOn      = "morphOn";      // Morph between stored snapshots
+
+    // === CHANNELS ===
+    inline constexpr const char* linkChannels = "linkChannels"; // Share modulation across all channels
+
+    // === CRUSH ===
+    inline constexpr const char* crushMode    = "crushMode";    // 0=Raw, 1=Clean (band-limited, dithered)
+
+    // === SATURATION ENGINE ===
+    inline constexpr const char* satEngine    = "satEngine";    // 0=Curve, 1=Hysteresis (tape modes)
+
+    // === ENVELOPE FOLLOWER ===
+    inline constexpr const char* envAttack    = "envAttack";    // Follower attack (ms)
+    inline constexpr const char* envRelease   = "envRelease";   // Follower release (ms)
+    inline constexpr const char* envMode      = "envMode";      // 0=Peak, 1=RMS
+    inline constexpr const char* envToAge     = "envToAge";     // Envelope -> age depth (-100 to +100%)
+    inline constexpr const char* envToNoise   = "envToNoise";   // Envelope -> noise depth
+    inline constexpr const char* envToSaturation = "envToSaturation"; // Envelope -> saturation depth
+    inline constexpr const char* envToFilter  = "envToFilter";  // Envelope -> filter cutoff depth
+
+    // Every parameter, in layout order
+    inline constexpr const char* all[] = {
+        bitcrush, downsample, noise, crackle,
+        wobble, dropout, saturation, age,
+        filterCutoff, filterRes, filterDrive,
+        mode,
+        mix, output, bypass,
+        morph, morphOn,
+        linkChannels,
+        crushMode,
+        satEngine,
+        envAttack, envRelease, envMode,
+        envToAge, envToNoise, envToSaturation, envToFilter
+    };
+    inline constexpr int numParameters = static_cast<int>(sizeof(all) / sizeof(all[0]));
+
+    // Position of each parameter in `all` (and in ParameterSnapshot::values)
+    namespace Index
+    {
+        enum : int
+        {
+            bitcrush, downsample, noise, crackle,
+            wobble, dropout, saturation, age,
+            filterCutoff, filterRes, filterDrive,
+            mode,
+            mix, output, bypass,
+            morph, morphOn,
+            linkChannels,
+            crushMode,
+            satEngine,
+            envAttack, envRelease, envMode,
+            envToAge, envToNoise, envToSaturation, envToFilter
+        };
+    }
+
     // Parameter ranges
     namespace Ranges
     {
@@ -50,7 +107,8 @@ namespace ParameterIDs
         inline constexpr float crackleMax = 100.0f;
         inline constexpr float crackleDefault = 0.0f;
 
-        // Wobble: 0-100%
+        // Wobble: 0-100%. The plugin reports 512 samples of latency at every
+        // setting, including 0%: see OxideDsp::getLatencySamples for why
         inline constexpr float wobbleMin = 0.0f;
         inline constexpr float wobbleMax = 100.0f;
         inline constexpr float wobbleDefault = 20.0f;
@@ -97,5 +155,32 @@ namespace ParameterIDs
         inline constexpr float outputMin = -24.0f;
         inline constexpr float outputMax = 12.0f;
         inline constexpr float outputDefault = 0.0f;
+
+        // Morph: 0% = snapshot A, 100% = snapshot B
+        inline constexpr float morphMin = 0.0f;
+        inline constexpr float morphMax = 100.0f;
+        inline constexpr float morphDefault = 0.0f;
+
+        // Crush mode: 0=Raw, 1=Clean
+        inline constexpr int crushModeDefault = 0;
+
+        // Saturation engine: 0=Curve, 1=Hysteresis
+        inline constexpr int satEngineDefault = 0;
+
+        // Envelope follower times (ms)
+        inline constexpr float envAttackMin = 0.5f;
+        inline constexpr float envAttackMax = 200.0f;
+        inline constexpr float envAttackDefault = 10.0f;
+        inline constexpr float envReleaseMin = 10.0f;
+        inline constexpr float envReleaseMax = 2000.0f;
+        inline constexpr float envReleaseDefault = 200.0f;
+
+        // Envelope follower: 0=Peak, 1=RMS
+        inline constexpr int envModeDefault = 1;
+
+        // Envelope routing depths: -100% to +100% of each target's range
+        inline constexpr float envDepthMin = -100.0f;
+        inline constexpr float envDepthMax = 100.0f;
+        inline constexpr float envDepthDefault = 0.0f;
     }
 }
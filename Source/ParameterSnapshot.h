@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ParameterIDs.h"
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <cstdint>
+
+/**
+    A complete set of parameter values in their native ranges (choice index,
+    bool as 0/1), indexed by ParameterIDs::Index. Plain data: safe to copy on
+    the audio thread and to hand between threads through a SnapshotBuffer.
+*/
+struct ParameterSnapshot
+{
+    std::array<float, ParameterIDs::numParameters> values {};
+
+    float operator[](int index) const noexcept { return values[static_cast<size_t>(index)]; }
+    float& operator[](int index) noexcept { return values[static_cast<size_t>(index)]; }
+
+    /** Reads the current value of every parameter (lock-free, any thread). */
+    static ParameterSnapshot capture(const juce::AudioProcessorValueTreeState& apvts)
+    {
+        ParameterSnapshot snapshot;
+        for (int i = 0; i < ParameterIDs::numParameters; ++i)
+            snapshot[i] = apvts.getRawParameterValue(ParameterIDs::all[i])->load();
+        return snapshot;
+    }
+
+    /** Linear blend from a (t = 0) to b (t = 1). Choice parameters switch at the
+        halfway point. Bypass, morph and channel linking aren't part of the sound
+        being morphed, so they're taken from live (the current control values). */
+    static ParameterSnapshot interpolate(const ParameterSnapshot& a, const ParameterSnapshot& b, float t,
+                                         const ParameterSnapshot& live) noexcept
+    {
+        ParameterSnapshot result = live;
+        for (int i = 0; i < ParameterIDs::numParameters; ++i)
+        {
+            switch (i)
+            {
+                case ParameterIDs::Index::mode:
+                case ParameterIDs::Index::crushMode:
+                case ParameterIDs::Index::satEngine:
+                case ParameterIDs::Index::envMode: result[i] = t < 0.5f ? a[i] : b[i]; break;
+                case ParameterIDs::Index::bypass:
+                case ParameterIDs::Index::morph:
+                case ParameterIDs::Index::morphOn:
+                case ParameterIDs::Index::linkChannels: break;
+                default:                           result[i] = a[i] + (b[i] - a[i]) * t; break;
+            }
+        }
+        return result;
+    }
+
+    /** Pushes every value to the host-facing parameters. Message thread. */
+    void applyTo(juce::AudioProcessorValueTreeState& apvts) const
+    {
+        for (int i = 0; i < ParameterIDs::numParameters; ++i)
+            if (auto* parameter = apvts.getParameter(ParameterIDs::all[i]))
+                parameter->setValueNotifyingHost(parameter->convertTo0to1((*this)[i]));
+    }
+};
+
+/**
+    Stable 32-bit key for a parameter ID (FNV-1a), used by the binary formats
+    so stored values can be matched to parameters by ID rather than position.
+*/
+constexpr std::uint32_t hashParameterID(const char* id) noexcept
+{
+    std::uint32_t hash = 2166136261u;
+    for (; *id != 0; ++id)
+        hash = (hash ^ static_cast<std::uint8_t>(*id)) * 16777619u;
+    return hash;
+}
+
+/** Position of a parameter in ParameterIDs::all by hash, or -1. */
+inline int findParameterIndex(std::uint32_t hash) noexcept
+{
+    for (int i = 0; i < ParameterIDs::numParameters; ++i)
+        if (hashParameterID(ParameterIDs::all[i]) == hash)
+            return i;
+    return -1;
+}
@@ -0,0 +1,129 @@
+#include "ParameterSync.h"
+#include "ParameterIDs.h"
+
+ParameterSync::ParameterSync(juce::AudioProcessorValueTreeState& apvts)
+{
+    for (auto* id : ParameterIDs::all)
+    {
+        auto* parameter = apvts.getParameter(id);
+        jassert(parameter != nullptr);
+
+        auto entry = std::make_unique<Entry>();
+        entry->parameter = parameter;
+        entry->id = id;
+
+        const int parameterIndex = parameter->getParameterIndex();
+        if (parameterIndex >= static_cast<int>(entryForParameterIndex.size()))
+            entryForParameterIndex.resize(static_cast<size_t>(parameterIndex) + 1, -1);
+        entryForParameterIndex[static_cast<size_t>(parameterIndex)] = static_cast<int>(entries.size());
+
+        parameter->addListener(this);
+        entries.push_back(std::move(entry));
+    }
+}
+
+ParameterSync::~ParameterSync()
+{
+    cancelPendingUpdate();
+
+    for (auto& entry : entries)
+        entry->parameter->removeListener(this);
+}
+
+void ParameterSync::setEmitter(EmitFunction emitter)
+{
+    emit = std::move(emitter);
+}
+
+void ParameterSync::markAllDirty()
+{
+    for (auto& entry : entries)
+        entry->dirty.store(true);
+
+    triggerAsyncUpdate();
+}
+
+void ParameterSync::parameterValueChanged(int parameterIndex, float)
+{
+    // May be called from the audio thread (host automation): only flag and defer
+    if (! juce::isPositiveAndBelow(parameterIndex, static_cast<int>(entryForParameterIndex.size())))
+        return;
+
+    if (juce::MessageManager::existsAndIsCurrentThread() && applyingFromUI)
+        return;
+
+    const int entryIndex = entryForParameterIndex[static_cast<size_t>(parameterIndex)];
+    if (entryIndex < 0)
+        return;
+
+    entries[static_cast<size_t>(entryIndex)]->dirty.store(true);
+    triggerAsyncUpdate();
+}
+
+void ParameterSync::handleAsyncUpdate()
+{
+    if (! emit)
+        return;
+
+    juce::DynamicObject::Ptr values = new juce::DynamicObject();
+    bool anyDirty = false;
+
+    for (auto& entry : entries)
+    {
+        if (! entry->dirty.exchange(false))
+            continue;
+
+        auto* parameter = entry->parameter;
+        values->setProperty(entry->id, parameter->convertFrom0to1(parameter->getValue()));
+        anyDirty = true;
+    }
+
+    if (! anyDirty)
+        return;
+
+    juce::DynamicObject::Ptr batch = new juce::DynamicObject();
+    batch->setProperty("values", juce::var(values.get()));
+    emit(juce::var(batch.get()));
+}
+
+ParameterSync::Entry* ParameterSync::findEntry(const juce::String& id)
+{
+    for (auto& entry : entries)
+        if (entry->id == id)
+            return entry.get();
+
+    return nullptr;
+}
+
+void ParameterSync::applyGestures(const juce::var& payload)
+{
+    auto* ops = payload.getProperty("ops", juce::var()).getArray();
+    if (ops == nullptr)
+        return;
+
+    const juce::ScopedValueSetter<bool> svs(applyingFromUI, true);
+
+    for (const auto& op : *ops)
+    {
+        auto* entry = findEntry(op.getProperty("id", "").toString());
+        if (entry == nullptr)
+            continue;
+
+        auto* parameter = entry->parameter;
+        const auto type = op.getProperty("type", "").toString();
+
+        if (type == "begin")
+        {
+            parameter->beginChangeGesture();
+        }
+        else if (type == "end")
+        {
+            parameter->endChangeGesture();
+        }
+        else if (type == "set")
+        {
+            const float value = static_cast<float>(op.getProperty("value", 0.0));
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+/**
+    Single batched parameter channel between the processor and the web UI.
+
+    Replaces one WebSliderRelay/attachment pair per parameter. Changes from the
+    host (automation, preset recall, state load) are flagged lock-free from any
+    thread and flushed as one "paramBatch" event per message-loop tick. Changes
+    from the UI arrive as one "paramGestures" event holding an ordered list of
+    begin/set/end operations, so gesture grouping survives batching.
+
+    Values on the wire are in each parameter's native range (choice parameters
+    send their index, bools send 0/1).
+*/
+class ParameterSync : private juce::AudioProcessorParameter::Listener,
+                      private juce::AsyncUpdater
+{
+public:
+    using EmitFunction = std::function<void(const juce::var&)>;
+
+    explicit ParameterSync(juce::AudioProcessorValueTreeState& apvts);
+    ~ParameterSync() override;
+
+    /** Where outgoing batches go, e.g. WebBrowserComponent::emitEventIfBrowserIsVisible. */
+    void setEmitter(EmitFunction emitter);
+
+    /** Queues every parameter for the next batch (initial sync after the page loads). */
+    void markAllDirty();
+
+    /** Applies an ordered list of { type: "begin" | "set" | "end", id, value } ops from the UI. */
+    void applyGestures(const juce::var& payload);
+
+private:
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+    void handleAsyncUpdate() override;
+
+    struct Entry
+    {
+        juce::RangedAudioParameter* parameter = nullptr;
+        juce::String id;
+        std::atomic<bool> dirty { false };
+    };
+
+    Entry* findEntry(const juce::String& id);
+
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::vector<int> entryForParameterIndex;
+    EmitFunction emit;
+
+    // True while UI gestures are being applied, so they aren't echoed back (message thread only)
+    bool applyingFromUI = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSync)
+};
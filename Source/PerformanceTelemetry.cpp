@@ -0,0 +1,149 @@
+#include "PerformanceTelemetry.h"
+
+namespace
+{
+    // Single writer: a relaxed load and store instead of a locked read-modify-write
+    template <typename T>
+    void bump(std::atomic<T>& counter, T amount = T(1)) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    void raise(std::atomic<T>& peak, T value) noexcept
+    {
+        if (value > peak.load(std::memory_order_relaxed))
+            peak.store(value, std::memory_order_relaxed);
+    }
+
+    const char* const modeNames[PerformanceTelemetry::kNumModes] = { "Cassette", "Vinyl", "VHS", "Radio" };
+}
+
+void PerformanceTelemetry::prepare(double newSampleRate) noexcept
+{
+    sampleRate.store(newSampleRate, std::memory_order_relaxed);
+    requestReset();
+}
+
+void PerformanceTelemetry::endBlock(juce::int64 startTicks, int numSamples, int configuration) noexcept
+{
+    const double rate = sampleRate.load(std::memory_order_relaxed);
+    if (numSamples <= 0 || rate <= 0.0)
+        return;
+
+    if (resetRequested.load(std::memory_order_acquire))
+    {
+        resetRequested.store(false, std::memory_order_relaxed);
+        clear();
+    }
+
+    const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    const auto load = static_cast<float>(elapsed * rate / numSamples);
+
+    lastLoad.store(load, std::memory_order_relaxed);
+    bump(histogram[static_cast<size_t>(juce::jlimit(0, kNumBins - 1, static_cast<int>(load / kBinWidth)))]);
+
+    if (load >= 1.0f)
+        bump(overruns);
+    else if (load >= kNearMissLoad)
+        bump(nearMisses);
+
+    for (auto* totals : { &overall, &configurations[static_cast<size_t>(juce::jlimit(0, kNumConfigurations - 1, configuration))] })
+    {
+        bump(totals->blocks);
+        bump(totals->loadSum, static_cast<double>(load));
+        raise(totals->peakLoad, load);
+    }
+}
+
+void PerformanceTelemetry::clear() noexcept
+{
+    const auto clearTotals = [](Totals& totals)
+    {
+        totals.blocks.store(0, std::memory_order_relaxed);
+        totals.loadSum.store(0.0, std::memory_order_relaxed);
+        totals.peakLoad.store(0.0f, std::memory_order_relaxed);
+    };
+
+    clearTotals(overall);
+    for (auto& totals : configurations)
+        clearTotals(totals);
+
+    for (auto& bin : histogram)
+        bin.store(0, std::memory_order_relaxed);
+
+    nearMisses.store(0, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+    lastLoad.store(0.0f, std::memory_order_relaxed);
+}
+
+PerformanceTelemetry::Snapshot PerformanceTelemetry::getSnapshot() const noexcept
+{
+    const auto read = [](const Totals& totals)
+    {
+        ConfigurationStats stats;
+        stats.blocks = totals.blocks.load(std::memory_order_relaxed);
+        stats.peakLoad = totals.peakLoad.load(std::memory_order_relaxed);
+        if (stats.blocks > 0)
+            stats.meanLoad = static_cast<float>(totals.loadSum.load(std::memory_order_relaxed) / static_cast<double>(stats.blocks));
+        return stats;
+    };
+
+    Snapshot snapshot;
+    snapshot.sampleRate = sampleRate.load(std::memory_order_relaxed);
+    snapshot.nearMisses = nearMisses.load(std::memory_order_relaxed);
+    snapshot.overruns = overruns.load(std::memory_order_relaxed);
+    snapshot.lastLoad = lastLoad.load(std::memory_order_relaxed);
+
+    const auto totals = read(overall);
+    snapshot.blocks = totals.blocks;
+    snapshot.meanLoad = totals.meanLoad;
+    snapshot.peakLoad = totals.peakLoad;
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        snapshot.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < configurations.size(); ++i)
+        snapshot.configurations[i] = read(configurations[i]);
+
+    return snapshot;
+}
+
+juce::var PerformanceTelemetry::Snapshot::toVar() const
+{
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("sampleRate", sampleRate);
+    data->setProperty("blocks", static_cast<juce::int64>(blocks));
+    data->setProperty("nearMisses", static_cast<juce::int64>(nearMisses));
+    data->setProperty("overruns", static_cast<juce::int64>(overruns));
+    data->setProperty("lastLoad", lastLoad);
+    data->setProperty("meanLoad", meanLoad);
+    data->setProperty("peakLoad", peakLoad);
+    data->setProperty("binWidth", kBinWidth);
+
+    juce::Array<juce::var> bins;
+    for (auto count : histogram)
+        bins.add(static_cast<juce::int64>(count));
+    data->setProperty("histogram", bins);
+
+    // Only configurations that have actually run
+    juce::Array<juce::var> byConfiguration;
+    for (int i = 0; i < kNumConfigurations; ++i)
+    {
+        const auto& stats = configurations[static_cast<size_t>(i)];
+        if (stats.blocks == 0)
+            continue;
+
+        juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+        entry->setProperty("mode", modeNames[i / 4]);
+        entry->setProperty("crushMode", (i & 2) != 0 ? "Clean" : "Raw");
+        entry->setProperty("satEngine", (i & 1) != 0 ? "Hysteresis" : "Curve");
+        entry->setProperty("blocks", static_cast<juce::int64>(stats.blocks));
+        entry->setProperty("meanLoad", stats.meanLoad);
+        entry->setProperty("peakLoad", stats.peakLoad);
+        byConfiguration.add(juce::var(entry.get()));
+    }
+    data->setProperty("configurations", byConfiguration);
+
+    return juce::var(data.get());
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+/**
+    Real-time deadline telemetry: how long each processBlock takes relative to
+    the buffer period it has to fit in.
+
+    The audio thread takes a high-resolution timestamp either side of a block
+    and records the load (processing time / buffer period) into a histogram,
+    counting near-misses and overruns, and into per-configuration totals keyed
+    by mode and engine choices. Every counter is a relaxed atomic with a single
+    writer, so recording is a handful of plain loads and stores; any thread can
+    read a snapshot, which is approximate across counters but never torn within
+    one.
+*/
+class PerformanceTelemetry
+{
+public:
+    static constexpr int kNumBins = 24;             // 5% of the buffer period per bin
+    static constexpr float kBinWidth = 0.05f;       // the last bin also takes everything above 115%
+    static constexpr float kNearMissLoad = 0.7f;    // close enough to the deadline to count
+    static constexpr int kNumModes = 4;
+    static constexpr int kNumConfigurations = kNumModes * 4;
+
+    /** Mode plus the two engine switches that change the cost of the chain the most. */
+    static int getConfiguration(int mode, bool cleanCrush, bool hysteresis) noexcept
+    {
+        return juce::jlimit(0, kNumModes - 1, mode) * 4 + (cleanCrush ? 2 : 0) + (hysteresis ? 1 : 0);
+    }
+
+    void prepare(double newSampleRate) noexcept;
+
+    /** Clears everything; the audio thread does it at the start of its next block. */
+    void requestReset() noexcept { resetRequested.store(true, std::memory_order_release); }
+
+    // === Audio thread ===
+    static juce::int64 beginBlock() noexcept { return juce::Time::getHighResolutionTicks(); }
+    void endBlock(juce::int64 startTicks, int numSamples, int configuration) noexcept;
+
+    // === Any thread ===
+    struct ConfigurationStats
+    {
+        juce::uint64 blocks = 0;
+        float meanLoad = 0.0f;
+        float peakLoad = 0.0f;
+    };
+
+    struct Snapshot
+    {
+        double sampleRate = 0.0;
+        juce::uint64 blocks = 0;
+        juce::uint64 nearMisses = 0;
+        juce::uint64 overruns = 0;
+        float lastLoad = 0.0f;
+        float meanLoad = 0.0f;
+        float peakLoad = 0.0f;
+        std::array<juce::uint64, kNumBins> histogram {};
+        std::array<ConfigurationStats, kNumConfigurations> configurations {};
+
+        /** JSON-friendly form, used for the editor event and headless dumps. */
+        juce::var toVar() const;
+    };
+
+    Snapshot getSnapshot() const noexcept;
+
+private:
+    struct Totals
+    {
+        std::atomic<juce::uint64> blocks { 0 };
+        std::atomic<double> loadSum { 0.0 };
+        std::atomic<float> peakLoad { 0.0f };
+    };
+
+    void clear() noexcept;
+
+    std::atomic<double> sampleRate { 0.0 };
+
+    // The one value other threads write, kept off the counters' cache lines
+    alignas(64) std::atomic<bool> resetRequested { false };
+
+    alignas(64) Totals overall;
+    std::atomic<juce::uint64> nearMisses { 0 };
+    std::atomic<juce::uint64> overruns { 0 };
+    std::atomic<float> lastLoad { 0.0f };
+    std::array<std::atomic<juce::uint64>, kNumBins> histogram {};
+    std::array<Totals, kNumConfigurations> configurations;
+};
@@ -7,74 +7,37 @@
 #endif
 
 OxideAudioProcessorEditor::OxideAudioProcessorEditor(OxideAudioProcessor& p)
-    : AudioProcessorEditor(&p), processorRef(p)
+    : AudioProcessorEditor(&p), processorRef(p), parameterSync(p.getAPVTS())
 {
+    OXIDE_TRACE_ZONE("Editor construction");
     setSize(850, 550);
     setResizable(false, false);
 
-    // Create relays BEFORE WebBrowserComponent
-    bitcrushRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::bitcrush);
-    downsampleRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::downsample);
-    noiseRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::noise);
-    crackleRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::crackle);
-    wobbleRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::wobble);
-    dropoutRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::dropout);
-    saturationRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::saturation);
-    ageRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::age);
-    filterCutoffRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::filterCutoff);
-    filterResRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::filterRes);
-    filterDriveRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::filterDrive);
-    modeRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::mode);
-    mixRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::mix);
-    outputRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::output);
-    bypassRelay = std::make_unique<juce::WebToggleButtonRelay>(ParameterIDs::bypass);
-
     setupWebView();
 
-    // Create attachments AFTER WebBrowserComponent
-    auto& apvts = processorRef.getAPVTS();
-    bitcrushAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::bitcrush), *bitcrushRelay, nullptr);
-    downsampleAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::downsample), *downsampleRelay, nullptr);
-    noiseAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::noise), *noiseRelay, nullptr);
-    crackleAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::crackle), *crackleRelay, nullptr);
-    wobbleAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::wobble), *wobbleRelay, nullptr);
-    dropoutAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::dropout), *dropoutRelay, nullptr);
-    saturationAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::saturation), *saturationRelay, nullptr);
-    ageAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::age), *ageRelay, nullptr);
-    filterCutoffAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::filterCutoff), *filterCutoffRelay, nullptr);
-    filterResAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::filterRes), *filterResRelay, nullptr);
-    filterDriveAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::filterDrive), *filterDriveRelay, nullptr);
-    modeAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::mode), *modeRelay, nullptr);
-    mixAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::mix), *mixRelay, nullptr);
-    outputAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::output), *outputRelay, nullptr);
-    bypassAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
-        *apvts.getParameter(ParameterIDs::bypass), *bypassRelay, nullptr);
-
-    // Start visualizer timer (60fps)
-    visualizerTimer.startTimerHz(60);
+    waveformColumns.resize(WaveformHistory::kFifoColumns);
+
+    parameterSync.setEmitter([this](const juce::var& batch) {
+        if (webView != nullptr)
+            webView->emitEventIfBrowserIsVisible("paramBatch", batch);
+    });
+
+    processorRef.addListener(this);
+
+    // Start visualizer timer at the selected frame budget
+    updateVisualizerTimer();
 }
 
 OxideAudioProcessorEditor::~OxideAudioProcessorEditor()
 {
+    processorRef.removeListener(this);
     visualizerTimer.stopTimer();
+    processorRef.getWaveformHistory().setEnabled(false);
 }
 
 void OxideAudioProcessorEditor::setupWebView()
 {
+    OXIDE_TRACE_ZONE("WebView setup");
     // Find resources directory
     auto executableFile = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
     auto executableDir = executableFile.getParentDirectory();
@@ -93,6 +56,7 @@ void OxideAudioProcessorEditor::setupWebView()
         .withResourceProvider(
             [this](const juce::String& url) -> std::optional<juce::WebBrowserComponent::Resource>
             {
+                OXIDE_TRACE_ZONE("WebView resource");
                 auto path = url;
                 if (path.startsWith("/")) path = path.substring(1);
                 if (path.isEmpty()) path = "index.html";
@@ -119,21 +83,12 @@ void OxideAudioProcessorEditor::setupWebView()
                     mimeType.toStdString()
                 };
             })
-        .withOptionsFrom(*bitcrushRelay)
-        .withOptionsFrom(*downsampleRelay)
-        .withOptionsFrom(*noiseRelay)
-        .withOptionsFrom(*crackleRelay)
-        .withOptionsFrom(*wobbleRelay)
-        .withOptionsFrom(*dropoutRelay)
-        .withOptionsFrom(*saturationRelay)
-        .withOptionsFrom(*ageRelay)
-        .withOptionsFrom(*filterCutoffRelay)
-        .withOptionsFrom(*filterResRelay)
-        .withOptionsFrom(*filterDriveRelay)
-        .withOptionsFrom(*modeRelay)
-        .withOptionsFrom(*mixRelay)
-        .withOptionsFrom(*outputRelay)
-        .withOptionsFrom(*bypassRelay)
+        .withEventListener("paramSyncRequest", [this](const juce::var&) {
+            parameterSync.markAllDirty();
+        })
+        .withEventListener("paramGestures", [this](const juce::var& data) {
+            parameterSync.applyGestures(data);
+        })
         .withEventListener("getActivationStatus", [this](const juce::var&) {
             juce::DynamicObject::Ptr data = new juce::DynamicObject();
 #if BEATCONNECT_ACTIVATION_ENABLED
@@ -145,6 +100,49 @@ void OxideAudioProcessorEditor::setupWebView()
 #endif
             webView->emitEventIfBrowserIsVisible("activationState", juce::var(data.get()));
         })
+        .withEventListener("visualizerPause", [this](const juce::var&) {
+            visualizerPausedByUI = true;
+            updateVisualizerTimer();
+        })
+        .withEventListener("visualizerResume", [this](const juce::var&) {
+            visualizerPausedByUI = false;
+            updateVisualizerTimer();
+            sendVisualizerConfig();
+        })
+        .withEventListener("setVisualizerRate", [this](const juce::var& data) {
+            processorRef.setVisualizerFrameRate(static_cast<int>(data.getProperty("frameRate", 60)));
+            updateVisualizerTimer();
+            sendVisualizerConfig();
+        })
+        .withEventListener("resetTelemetry", [this](const juce::var&) {
+            processorRef.resetTelemetry();
+            sendTelemetry();
+        })
+        .withEventListener("resetLoudness", [this](const juce::var&) {
+            processorRef.resetLoudness();
+        })
+        .withEventListener("matchLoudness", [this](const juce::var&) {
+            if (! processorRef.matchOutputLoudness())
+                DBG("Loudness match skipped: input or output below the gate");
+        })
+        .withEventListener("setNativeEditor", [this](const juce::var& data) {
+            processorRef.setUsesNativeEditor(static_cast<bool>(data.getProperty("enabled", false)));
+        })
+        .withEventListener("storeMorphSnapshot", [this](const juce::var& data) {
+            processorRef.storeMorphSnapshot(static_cast<int>(data.getProperty("slot", 0)) == 0 ? 0 : 1);
+        })
+        .withEventListener("getPresets", [this](const juce::var&) {
+            processorRef.reloadUserPresets();
+            sendPresetState();
+        })
+        .withEventListener("loadPreset", [this](const juce::var& data) {
+            processorRef.setCurrentProgram(static_cast<int>(data.getProperty("index", -1)));
+        })
+        .withEventListener("savePreset", [this](const juce::var& data) {
+            const auto name = data.getProperty("name", "").toString().trim();
+            if (name.isNotEmpty())
+                processorRef.saveUserPreset(name);
+        })
 #if BEATCONNECT_ACTIVATION_ENABLED
         .withEventListener("activateLicense", [this](const juce::var& data) {
             handleActivateLicense(data);
@@ -173,18 +171,222 @@ void OxideAudioProcessorEditor::setupWebView()
 #endif
 }
 
+void OxideAudioProcessorEditor::updateVisualizerTimer()
+{
+    // Paused by the UI (visualizer not on screen): no work at all until it resumes us
+    if (webView == nullptr || visualizerPausedByUI)
+    {
+        visualizerTimer.stopTimer();
+        processorRef.getWaveformHistory().setEnabled(false);
+        return;
+    }
+
+    // Hidden (closed, minimised, covered): nothing captured, sent or ticking
+    if (! isShowing())
+    {
+        visualizerTimer.stopTimer();
+        processorRef.getWaveformHistory().setEnabled(false);
+        stoppedWhileHidden = true;
+        return;
+    }
+
+    stoppedWhileHidden = false;
+    processorRef.getWaveformHistory().setEnabled(true);
+    visualizerTimer.restart();
+}
+
+void OxideAudioProcessorEditor::sendVisualizerConfig()
+{
+    if (webView == nullptr) return;
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("frameRate", processorRef.getVisualizerFrameRate());
+    webView->emitEventIfBrowserIsVisible("visualizerConfig", juce::var(data.get()));
+}
+
+void OxideAudioProcessorEditor::sendTelemetry()
+{
+    if (webView == nullptr) return;
+
+    webView->emitEventIfBrowserIsVisible("telemetryData", processorRef.getTelemetry().getSnapshot().toVar());
+}
+
+void OxideAudioProcessorEditor::sendLoudness()
+{
+    if (webView == nullptr) return;
+
+    webView->emitEventIfBrowserIsVisible("loudnessData", processorRef.getLoudness().toVar());
+}
+
+bool OxideAudioProcessorEditor::sendWaveform()
+{
+    if (webView == nullptr) return false;
+
+    const int numColumns = processorRef.getWaveformHistory().read(waveformColumns.data(), static_cast<int>(waveformColumns.size()));
+    if (numColumns == 0) return false;
+
+    // Interleaved min/max pairs, oldest column first
+    juce::Array<juce::var> pre, post;
+    pre.ensureStorageAllocated(numColumns * 2);
+    post.ensureStorageAllocated(numColumns * 2);
+
+    bool silent = true;
+    for (int i = 0; i < numColumns; ++i)
+    {
+        const auto& column = waveformColumns[static_cast<size_t>(i)];
+        pre.add(column.preMin, column.preMax);
+        post.add(column.postMin, column.postMax);
+        silent = silent && column.preMin == 0.0f && column.preMax == 0.0f
+                        && column.postMin == 0.0f && column.postMax == 0.0f;
+    }
+
+    if (silent && waveformSilent)
+        return false;
+
+    waveformSilent = silent;
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("columnRate", WaveformHistory::kColumnRate);
+    data->setProperty("pre", pre);
+    data->setProperty("post", post);
+    webView->emitEventIfBrowserIsVisible("waveformData", juce::var(data.get()));
+    return ! silent;
+}
+
+void OxideAudioProcessorEditor::sendPresetState()
+{
+    if (webView == nullptr)
+        return;
+
+    const auto bank = processorRef.getPresetBank().getPresets();
+    juce::Array<juce::var> presets;
+
+    for (int i = 0; i < static_cast<int>(bank->size()); ++i)
+    {
+        const auto& preset = (*bank)[static_cast<size_t>(i)];
+
+        juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+        entry->setProperty("index", i);
+        entry->setProperty("name", preset.name);
+        entry->setProperty("category", preset.category);
+        entry->setProperty("isFactory", preset.isFactory);
+        presets.add(juce::var(entry.get()));
+    }
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("presets", presets);
+    data->setProperty("current", processorRef.getCurrentProgram());
+    webView->emitEventIfBrowserIsVisible("presetState", juce::var(data.get()));
+}
+
+void OxideAudioProcessorEditor::audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details)
+{
+    if (! details.programChanged)
+        return;
+
+    // Hosts may change program from any thread
+    juce::MessageManager::callAsync([safeThis = juce::Component::SafePointer<OxideAudioProcessorEditor>(this)] {
+        if (safeThis != nullptr)
+            safeThis->sendPresetState();
+    });
+}
+
+bool OxideAudioProcessorEditor::VisualizerFrame::differsFrom(const VisualizerFrame& other) const
+{
+    constexpr float epsilon = 1.0e-4f;
+    auto changed = [epsilon](float a, float b) { return std::abs(a - b) > epsilon; };
+
+    if (mode != other.mode || bypassed != other.bypassed)
+        return true;
+
+    if (changed(rms, other.rms) || changed(peak, other.peak)
+        || changed(crackleActivity, other.crackleActivity) || changed(degradation, other.degradation))
+        return true;
+
+    // The wobble LFO keeps running on silence; it only matters while there is signal to draw
+    return rms > epsilon && changed(wobblePhase, other.wobblePhase);
+}
+
+void OxideAudioProcessorEditor::VisualizerTimer::restart()
+{
+    unchangedFrames = 0;
+    idle = false;
+    startTimerHz(editor.processorRef.getVisualizerFrameRate());
+}
+
 void OxideAudioProcessorEditor::VisualizerTimer::timerCallback()
 {
-    if (editor.webView == nullptr) return;
+    OXIDE_TRACE_ZONE("Visualizer frame");
+    if (editor.webView == nullptr)
+    {
+        stopTimer();
+        return;
+    }
+
+    // Hidden without a visibility callback: stop until we're shown again
+    if (! editor.isShowing())
+    {
+        editor.updateVisualizerTimer();
+        return;
+    }
+
+    auto& processor = editor.processorRef;
+
+    // Telemetry and loudness ride along at their own slower rate, idle or not
+    const auto now = juce::Time::getMillisecondCounter();
+    if (now - lastTelemetryTime >= kTelemetryIntervalMs)
+    {
+        lastTelemetryTime = now;
+        editor.sendTelemetry();
+        editor.sendLoudness();
+    }
+
+    VisualizerFrame frame;
+    frame.rms = processor.getCurrentRMS();
+    frame.peak = processor.getCurrentPeak();
+    frame.wobblePhase = processor.getWobblePhase();
+    frame.crackleActivity = processor.getCrackleActivity();
+    frame.degradation = processor.getDegradationAmount();
+    frame.mode = processor.getCurrentMode();
+    frame.bypassed = processor.isBypassed();
+
+    // The waveform keeps the frame rate up on its own (hiss on a silent input, say)
+    const bool waveformMoving = editor.sendWaveform();
+
+    if (! frame.differsFrom(lastFrame))
+    {
+        if (waveformMoving)
+        {
+            if (idle)
+                restart();
+            unchangedFrames = 0;
+            return;
+        }
+
+        // Nothing new to draw: after a short grace period drop to a slow poll
+        const int frameRate = processor.getVisualizerFrameRate();
+        if (! idle && ++unchangedFrames >= static_cast<int>(frameRate * kIdleBackoffSeconds))
+        {
+            idle = true;
+            startTimerHz(kIdlePollHz);
+        }
+        return;
+    }
+
+    if (idle)
+        restart();
+
+    unchangedFrames = 0;
+    lastFrame = frame;
 
     juce::DynamicObject::Ptr data = new juce::DynamicObject();
-    data->setProperty("rms", editor.processorRef.getCurrentRMS());
-    data->setProperty("peak", editor.processorRef.getCurrentPeak());
-    data->setProperty("wobblePhase", editor.processorRef.getWobblePhase());
-    data->setProperty("crackleActivity", editor.processorRef.getCrackleActivity());
-    data->setProperty("mode", editor.processorRef.getCurrentMode());
-    data->setProperty("bypassed", editor.processorRef.isBypassed());
-    data->setProperty("degradation", editor.processorRef.getDegradationAmount());
+    data->setProperty("rms", frame.rms);
+    data->setProperty("peak", frame.peak);
+    data->setProperty("wobblePhase", frame.wobblePhase);
+    data->setProperty("crackleActivity", frame.crackleActivity);
+    data->setProperty("mode", frame.mode);
+    data->setProperty("bypassed", frame.bypassed);
+    data->setProperty("degradation", frame.degradation);
 
     editor.webView->emitEventIfBrowserIsVisible("visualizerData", juce::var(data.get()));
 }
@@ -269,6 +471,15 @@ void OxideAudioProcessorEditor::handleGetActivationStatus()
 void OxideAudioProcessorEditor::paint(juce::Graphics& g)
 {
     g.fillAll(juce::Colour(0xff0a0a0c));
+
+    // Painted, so on screen again: resume if nothing told us (not from inside paint)
+    if (std::exchange(stoppedWhileHidden, false))
+    {
+        juce::MessageManager::callAsync([safeThis = juce::Component::SafePointer<OxideAudioProcessorEditor>(this)] {
+            if (safeThis != nullptr)
+                safeThis->visibilityChanged();
+        });
+    }
 }
 
 void OxideAudioProcessorEditor::resized()
@@ -276,3 +487,20 @@ void OxideAudioProcessorEditor::resized()
     if (webView)
         webView->setBounds(getLocalBounds());
 }
+
+void OxideAudioProcessorEditor::visibilityChanged()
+{
+    // Batches are dropped while the browser is hidden, so resync on show
+    if (isShowing())
+    {
+        parameterSync.markAllDirty();
+        sendPresetState();
+    }
+
+    updateVisualizerTimer();
+}
+
+void OxideAudioProcessorEditor::parentHierarchyChanged()
+{
+    updateVisualizerTimer();
+}
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "PluginProcessor.h"
+#include "ParameterSync.h"
 #include <juce_gui_extra/juce_gui_extra.h>
 
-class OxideAudioProcessorEditor : public juce::AudioProcessorEditor
+class OxideAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                  private juce::AudioProcessorListener
 {
 public:
     explicit OxideAudioProcessorEditor(OxideAudioProcessor&);
@@ -11,10 +13,22 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
 
 private:
     void setupWebView();
     void handleWebMessage(const juce::var& message);
+    void updateVisualizerTimer();
+    void sendVisualizerConfig();
+    void sendTelemetry();
+    void sendLoudness();
+    bool sendWaveform();
+    void sendPresetState();
+
+    // AudioProcessorListener: resend the preset list when the host changes program
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override {}
+    void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details) override;
 
 #if BEATCONNECT_ACTIVATION_ENABLED
     void sendActivationState();
@@ -25,53 +39,61 @@ private:
 
     OxideAudioProcessor& processorRef;
 
-    // Parameter relays for bidirectional sync
-    std::unique_ptr<juce::WebSliderRelay> bitcrushRelay;
-    std::unique_ptr<juce::WebSliderRelay> downsampleRelay;
-    std::unique_ptr<juce::WebSliderRelay> noiseRelay;
-    std::unique_ptr<juce::WebSliderRelay> crackleRelay;
-    std::unique_ptr<juce::WebSliderRelay> wobbleRelay;
-    std::unique_ptr<juce::WebSliderRelay> dropoutRelay;
-    std::unique_ptr<juce::WebSliderRelay> saturationRelay;
-    std::unique_ptr<juce::WebSliderRelay> ageRelay;
-    std::unique_ptr<juce::WebSliderRelay> filterCutoffRelay;
-    std::unique_ptr<juce::WebSliderRelay> filterResRelay;
-    std::unique_ptr<juce::WebSliderRelay> filterDriveRelay;
-    std::unique_ptr<juce::WebSliderRelay> modeRelay;
-    std::unique_ptr<juce::WebSliderRelay> mixRelay;
-    std::unique_ptr<juce::WebSliderRelay> outputRelay;
-    std::unique_ptr<juce::WebToggleButtonRelay> bypassRelay;
-
-    // Parameter attachments
-    std::unique_ptr<juce::WebSliderParameterAttachment> bitcrushAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> downsampleAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> noiseAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> crackleAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> wobbleAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> dropoutAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> saturationAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> ageAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> filterCutoffAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> filterResAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> filterDriveAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> modeAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> mixAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> outputAttachment;
-    std::unique_ptr<juce::WebToggleButtonParameterAttachment> bypassAttachment;
+    // Batched parameter channel to the web UI (one event per tick instead of one per parameter)
+    ParameterSync parameterSync;
 
     std::unique_ptr<juce::WebBrowserComponent> webView;
     juce::File resourcesDir_;
 
-    // Timer for visualizer updates
+    // Set by the web UI when the visualizer is unmounted or the page is hidden
+    bool visualizerPausedByUI = false;
+
+    // Waveform columns drained each tick; silence is sent once, not every frame
+    std::vector<WaveformHistory::Column> waveformColumns;
+    bool waveformSilent = false;
+
+    // Snapshot of what was last pushed to the visualizer
+    struct VisualizerFrame
+    {
+        float rms = 0.0f;
+        float peak = 0.0f;
+        float wobblePhase = 0.0f;
+        float crackleActivity = 0.0f;
+        float degradation = 0.0f;
+        int mode = -1;
+        bool bypassed = false;
+
+        bool differsFrom(const VisualizerFrame& other) const;
+    };
+
+    // Timer for visualizer updates. Runs at the selected frame budget while data
+    // is changing and backs off to a slow poll once the signal goes idle. It
+    // stops whenever the editor isn't showing (or the UI pauses the visualizer),
+    // including on its own next tick if the host hid us without a visibility
+    // callback, and starts again from visibilityChanged().
     class VisualizerTimer : public juce::Timer
     {
     public:
         VisualizerTimer(OxideAudioProcessorEditor& e) : editor(e) {}
         void timerCallback() override;
+        void restart();
     private:
         OxideAudioProcessorEditor& editor;
+        VisualizerFrame lastFrame;
+        int unchangedFrames = 0;
+        bool idle = false;
+        juce::uint32 lastTelemetryTime = 0;
     };
     VisualizerTimer visualizerTimer { *this };
 
+    // Stopped because we weren't showing. Minimise/restore and uncovering don't
+    // always reach the editor, so the first paint after that (which only happens
+    // once we're on screen) checks once and resumes.
+    bool stoppedWhileHidden = false;
+
+    static constexpr int kIdlePollHz = 4;
+    static constexpr float kIdleBackoffSeconds = 0.5f;
+    static constexpr juce::uint32 kTelemetryIntervalMs = 250;   // block timing and loudness change slowly; no need for the frame rate
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OxideAudioProcessorEditor)
 };
@@ -6,27 +6,23 @@
 */
 
 #include "PluginProcessor.h"
+#if ! OXIDE_HEADLESS
+#include "NativeEditor.h"
 #include "PluginEditor.h"
+#endif
 #include "ParameterIDs.h"
 
 OxideAudioProcessor::OxideAudioProcessor()
     : AudioProcessor(BusesProperties()
         .withInput("Input", juce::AudioChannelSet::stereo(), true)
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts(*this, nullptr, "Parameters", createParameterLayout()),
-      noiseGen(std::random_device{}())
+      apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
     loadProjectData();
 
-    // Initialize mode characteristics
-    // Cassette: warm, wobbly, hissy
-    modeChars[0] = { 0.6f, 1.0f, 1.0f, 0.6f, 40.0f, 14000.0f, 1.0f };
-    // Vinyl: crackly, warm, slight wobble
-    modeChars[1] = { 0.4f, 0.3f, 0.5f, 0.4f, 30.0f, 16000.0f, 0.5f };
-    // VHS: heavy wobble, muffled, artifacts
-    modeChars[2] = { 0.8f, 2.0f, 0.7f, 0.7f, 60.0f, 10000.0f, 1.5f };
-    // Radio: bandpass, noise, compression
-    modeChars[3] = { 1.0f, 0.1f, 2.0f, 0.8f, 300.0f, 5000.0f, 2.0f };
+    // Both morph slots start at the default sound
+    morphSlots.a = morphSlots.b = PresetBank::getDefaultSnapshot();
+    publishMorphSnapshots();
 }
 
 OxideAudioProcessor::~OxideAudioProcessor()
@@ -133,6 +129,71 @@ juce::AudioProcessorValueTreeState::ParameterLayout OxideAudioProcessor::createP
         juce::ParameterID { bypass, 1 }, "Bypass", false
     ));
 
+    // Morph section
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { morph, 1 }, "Morph",
+        juce::NormalisableRange<float>(morphMin, morphMax, 0.1f),
+        morphDefault, juce::AudioParameterFloatAttributes().withLabel("%")
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { morphOn, 1 }, "Morph On", false
+    ));
+
+    // Channels
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { linkChannels, 1 }, "Link Channels", true
+    ));
+
+    // Crush character: the original hold/round, or band-limited and dithered
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { crushMode, 1 }, "Crush Mode",
+        juce::StringArray { "Raw", "Clean" },
+        crushModeDefault
+    ));
+
+    // Saturation engine for the tape modes: static curve or magnetic hysteresis
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { satEngine, 1 }, "Saturation Engine",
+        juce::StringArray { "Curve", "Hysteresis" },
+        satEngineDefault
+    ));
+
+    // Envelope follower
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { envAttack, 1 }, "Envelope Attack",
+        juce::NormalisableRange<float>(envAttackMin, envAttackMax, 0.1f, 0.4f),
+        envAttackDefault, juce::AudioParameterFloatAttributes().withLabel("ms")
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { envRelease, 1 }, "Envelope Release",
+        juce::NormalisableRange<float>(envReleaseMin, envReleaseMax, 1.0f, 0.4f),
+        envReleaseDefault, juce::AudioParameterFloatAttributes().withLabel("ms")
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { envMode, 1 }, "Envelope Mode",
+        juce::StringArray { "Peak", "RMS" },
+        envModeDefault
+    ));
+
+    const std::pair<const char*, const char*> envelopeRoutes[] = {
+        { envToAge, "Envelope > Age" },
+        { envToNoise, "Envelope > Noise" },
+        { envToSaturation, "Envelope > Saturation" },
+        { envToFilter, "Envelope > Filter" },
+    };
+
+    for (const auto& [id, name] : envelopeRoutes)
+    {
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID { id, 1 }, name,
+            juce::NormalisableRange<float>(envDepthMin, envDepthMax, 0.1f),
+            envDepthDefault, juce::AudioParameterFloatAttributes().withLabel("%")
+        ));
+    }
+
     return { params.begin(), params.end() };
 }
 
@@ -192,87 +253,53 @@ bool OxideAudioProcessor::hasActivationEnabled() const
 
 void OxideAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    currentSampleRate = sampleRate;
-
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock * 2);
-    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
-
-    // Prepare filters
-    lowpassFilter.prepare(spec);
-    lowpassFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-
-    highpassFilter.prepare(spec);
-    highpassFilter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
+    // Per-channel state, sized for whatever layout the host gave us
+    const int numChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels(), 1);
+    const auto initial = ParameterSnapshot::capture(apvts);
 
-    bandpassFilter.prepare(spec);
-    bandpassFilter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+    // Only the core matching the host's precision is used; release the other
+    if (isUsingDoublePrecision())
+    {
+        doubleDsp.prepare(sampleRate, samplesPerBlock, numChannels, initial);
+        floatDsp.release();
+    }
+    else
+    {
+        floatDsp.prepare(sampleRate, samplesPerBlock, numChannels, initial);
+        doubleDsp.release();
+    }
 
-    tapeHeadFilter.prepare(spec);
-    tapeHeadFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    tapeHeadFilter.setCutoffFrequency(80.0f);  // Tape head bump
+    telemetry.prepare(sampleRate);
+    waveform.prepare(sampleRate, samplesPerBlock);
+    loudness.prepare(sampleRate, samplesPerBlock, LoudnessMeter::getChannelWeights(getChannelLayoutOfBus(false, 0), numChannels));
 
-    // Reset delay lines
-    std::memset(delayLine, 0, sizeof(delayLine));
-    delayWritePos = 0;
+    // Constant whatever the settings (even at Wobble 0), so hosts can compensate
+    // once; OxideDsp::getLatencySamples explains why it doesn't follow Wobble
+    setLatencySamples(OxideDsp<float>::getLatencySamples());
 
-    // Reset envelopes and states
-    for (int i = 0; i < 2; ++i)
-    {
-        bitcrushHold[i] = 0.0f;
-        bitcrushCounter[i] = 0;
-        lastSample[i] = 0.0f;
-        sampleHoldCounter[i] = 0.0f;
-        crackleEnvelope[i] = 0.0f;
-        dcState[i] = 0.0f;
-        modulatedDelay[i] = 512.0f;
-    }
+    DBG("prepareToPlay - sampleRate: " + juce::String(sampleRate) + ", blockSize: " + juce::String(samplesPerBlock)
+        + (isUsingDoublePrecision() ? ", double precision" : ", single precision"));
+}
 
-    dropoutEnvelope = 1.0f;
-    dropoutTimer = 0.0f;
-    inDropout = false;
-    wowPhase = 0.0f;
-    flutterPhase = 0.0f;
-    driftPhase = 0.0f;
-
-    // Parameter smoothing
-    const double smoothTime = 0.02;
-    bitcrushSmoothed.reset(sampleRate, smoothTime);
-    downsampleSmoothed.reset(sampleRate, smoothTime);
-    noiseSmoothed.reset(sampleRate, smoothTime);
-    wobbleSmoothed.reset(sampleRate, smoothTime);
-    saturationSmoothed.reset(sampleRate, smoothTime);
-    filterCutoffSmoothed.reset(sampleRate, 0.05);
-    mixSmoothed.reset(sampleRate, smoothTime);
-
-    // Initialize to current values
-    bitcrushSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue(ParameterIDs::bitcrush)->load());
-    downsampleSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue(ParameterIDs::downsample)->load());
-    noiseSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue(ParameterIDs::noise)->load());
-    wobbleSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue(ParameterIDs::wobble)->load());
-    saturationSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue(ParameterIDs::saturation)->load());
-    filterCutoffSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue(ParameterIDs::filterCutoff)->load());
-    mixSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue(ParameterIDs::mix)->load());
-
-    // DC blocker coefficient
-    dcCoeff = 1.0f - (20.0f / static_cast<float>(sampleRate));
-
-    DBG("prepareToPlay - sampleRate: " + juce::String(sampleRate) + ", blockSize: " + juce::String(samplesPerBlock));
+double OxideAudioProcessor::getTailLengthSeconds() const
+{
+    const double sampleRate = getSampleRate();
+    return OxideDsp<float>::getTailSeconds(sampleRate > 0.0 ? sampleRate : 44100.0);
 }
 
 void OxideAudioProcessor::releaseResources()
 {
-    lowpassFilter.reset();
-    highpassFilter.reset();
-    bandpassFilter.reset();
-    tapeHeadFilter.reset();
+    DBG("Block timing: " + juce::JSON::toString(telemetry.getSnapshot().toVar(), true));
+
+    floatDsp.reset();
+    doubleDsp.reset();
+    loudness.release();
 }
 
 bool OxideAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout from mono to immersive; per-channel state is sized in prepareToPlay
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
@@ -282,12 +309,36 @@ bool OxideAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) con
 }
 
 void OxideAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    const auto start = PerformanceTelemetry::beginBlock();
+    process(buffer, floatDsp);
+
+    // Offline bounces have no deadline to measure against
+    if (! isNonRealtime())
+        telemetry.endBlock(start, buffer.getNumSamples(), telemetryConfiguration);
+}
+
+void OxideAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    const auto start = PerformanceTelemetry::beginBlock();
+    process(buffer, doubleDsp);
+
+    if (! isNonRealtime())
+        telemetry.endBlock(start, buffer.getNumSamples(), telemetryConfiguration);
+}
+
+template <typename SampleType>
+void OxideAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, OxideDsp<SampleType>& dsp)
 {
     juce::ScopedNoDenormals noDenormals;
+    OXIDE_TRACE_THREAD("Audio");
+    OXIDE_TRACE_ZONE("processBlock");
+
+    // Offline renders may run on the message thread, which does take stateLock
+    audioThread.store(isNonRealtime() ? nullptr : juce::Thread::getCurrentThreadId(), std::memory_order_relaxed);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
-    const float sampleRate = static_cast<float>(currentSampleRate);
 
     // Clear unused channels
     for (int i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
@@ -296,414 +347,460 @@ void OxideAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     // =========================================================================
     // GET PARAMETERS
     // =========================================================================
-    const float bitcrushVal = apvts.getRawParameterValue(ParameterIDs::bitcrush)->load();
-    const float downsampleVal = apvts.getRawParameterValue(ParameterIDs::downsample)->load();
-    const float noiseVal = apvts.getRawParameterValue(ParameterIDs::noise)->load();
-    const float crackleVal = apvts.getRawParameterValue(ParameterIDs::crackle)->load();
-    const float wobbleVal = apvts.getRawParameterValue(ParameterIDs::wobble)->load();
-    const float dropoutVal = apvts.getRawParameterValue(ParameterIDs::dropout)->load();
-    const float saturationVal = apvts.getRawParameterValue(ParameterIDs::saturation)->load();
-    const float ageVal = apvts.getRawParameterValue(ParameterIDs::age)->load();
-    const float filterCutoffVal = apvts.getRawParameterValue(ParameterIDs::filterCutoff)->load();
-    const float filterResVal = apvts.getRawParameterValue(ParameterIDs::filterRes)->load();
-    const float filterDriveVal = apvts.getRawParameterValue(ParameterIDs::filterDrive)->load();
-    const int modeVal = static_cast<int>(apvts.getRawParameterValue(ParameterIDs::mode)->load());
-    const float mixVal = apvts.getRawParameterValue(ParameterIDs::mix)->load();
-    const float outputVal = apvts.getRawParameterValue(ParameterIDs::output)->load();
-    const bool bypassVal = apvts.getRawParameterValue(ParameterIDs::bypass)->load() > 0.5f;
+    OXIDE_TRACE_ZONE_BEGIN(parametersZone, "Read parameters");
+    typename OxideDsp<SampleType>::BlockSettings settings;
+    settings.params = readParameters();
+
+    // A/B morph: one blend per block, then the usual smoothers take it from here
+    morphSnapshots.acquire();
+    const auto& morphPair = morphSnapshots.getReadBuffer();
+    const bool morphActive = settings.params[ParameterIDs::Index::morphOn] > 0.5f;
+    const float morphPos = settings.params[ParameterIDs::Index::morph] / 100.0f;
+
+    // Modes either side of the morph; modeBlend crossfades their characteristics
+    settings.modeA = juce::jlimit(0, 3, static_cast<int>(settings.params[ParameterIDs::Index::mode]));
+    settings.modeB = settings.modeA;
+
+    if (morphActive)
+    {
+        settings.params = ParameterSnapshot::interpolate(morphPair.a, morphPair.b, morphPos, settings.params);
+        settings.modeA = juce::jlimit(0, 3, static_cast<int>(morphPair.a[ParameterIDs::Index::mode]));
+        settings.modeB = juce::jlimit(0, 3, static_cast<int>(morphPair.b[ParameterIDs::Index::mode]));
+    }
+
+    settings.modeBlend = settings.modeA != settings.modeB ? morphPos : 0.0f;
+
+    const int modeVal = juce::jlimit(0, 3, static_cast<int>(settings.params[ParameterIDs::Index::mode]));
+    const bool bypassVal = settings.params[ParameterIDs::Index::bypass] > 0.5f;
 
     // Store for UI
-    currentMode.store(modeVal);
-    bypassed.store(bypassVal);
-
-    // Update smoothed parameters
-    bitcrushSmoothed.setTargetValue(bitcrushVal);
-    downsampleSmoothed.setTargetValue(downsampleVal);
-    noiseSmoothed.setTargetValue(noiseVal);
-    wobbleSmoothed.setTargetValue(wobbleVal);
-    saturationSmoothed.setTargetValue(saturationVal);
-    filterCutoffSmoothed.setTargetValue(filterCutoffVal);
-    mixSmoothed.setTargetValue(mixVal);
+    meters.mode.store(modeVal);
+    meters.bypassed.store(bypassVal);
+
+    // Hysteresis only runs in the tape modes (Cassette, VHS)
+    telemetryConfiguration = PerformanceTelemetry::getConfiguration(
+        modeVal,
+        settings.params[ParameterIDs::Index::crushMode] > 0.5f,
+        settings.params[ParameterIDs::Index::satEngine] > 0.5f && (modeVal == 0 || modeVal == 2));
+
+    OXIDE_TRACE_ZONE_END(parametersZone);
 
     // Visualizer data (pre-processing)
+    OXIDE_TRACE_ZONE_BEGIN(inputZone, "Input meters");
     float inputRms = 0.0f;
     float peak = 0.0f;
     for (int ch = 0; ch < numChannels; ++ch)
     {
-        inputRms += buffer.getRMSLevel(ch, 0, numSamples);
-        peak = std::max(peak, buffer.getMagnitude(ch, 0, numSamples));
+        inputRms += static_cast<float>(buffer.getRMSLevel(ch, 0, numSamples));
+        peak = std::max(peak, static_cast<float>(buffer.getMagnitude(ch, 0, numSamples)));
     }
     inputRms /= static_cast<float>(numChannels);
-    currentRMS.store(inputRms);
-    currentPeak.store(peak);
+    meters.rms.store(inputRms);
+    meters.peak.store(peak);
+    waveform.capturePre(buffer);
+    loudness.pushInput(buffer);
+    OXIDE_TRACE_ZONE_END(inputZone);
 
-    if (bypassVal) return;
+    if (bypassVal)
+    {
+        dsp.processBypassed(buffer);
+        waveform.capturePost(buffer);
+        loudness.pushOutput(buffer);
+        return;
+    }
 
-    // Get mode characteristics
-    const auto& mc = modeChars[modeVal];
+    // =========================================================================
+    // PROCESSING
+    // =========================================================================
+    const auto blockMeters = dsp.process(buffer, settings);
+    waveform.capturePost(buffer);
+    loudness.pushOutput(buffer);
+
+    meters.degradation.store(blockMeters.degradation);
+    meters.wobblePhase.store(blockMeters.wobblePhase);
+    if (blockMeters.crackleActivity >= 0.0f)
+        meters.crackleActivity.store(blockMeters.crackleActivity);
+}
 
-    // Age affects all degradation
-    const float ageMult = 1.0f + (ageVal / 100.0f) * 2.0f;
+void OxideAudioProcessor::storeMorphSnapshot(int slot)
+{
+    auto snapshot = ParameterSnapshot::capture(apvts);
 
-    // Store overall degradation for visualizer
-    degradationAmount.store((bitcrushVal + downsampleVal + noiseVal + wobbleVal + saturationVal) / 500.0f * ageMult);
+    const auto sl = lockState();
+    (slot == 0 ? morphSlots.a : morphSlots.b) = snapshot;
+    publishMorphSnapshots();
+}
 
-    // =========================================================================
-    // STORE DRY SIGNAL
-    // =========================================================================
-    juce::AudioBuffer<float> dryBuffer;
-    dryBuffer.makeCopyOf(buffer);
+void OxideAudioProcessor::publishMorphSnapshots()
+{
+    morphSnapshots.getWriteBuffer() = morphSlots;
+    morphSnapshots.publish();
+}
 
-    // =========================================================================
-    // PROCESSING
-    // =========================================================================
+bool OxideAudioProcessor::matchOutputLoudness()
+{
+    const auto in = loudness.getReading(LoudnessMeter::input);
+    const auto out = loudness.getReading(LoudnessMeter::output);
 
-    // LFO increments for wow/flutter
-    const float wowInc = (0.5f * mc.wobbleRate) / sampleRate;      // ~0.5 Hz wow
-    const float flutterInc = (8.0f * mc.wobbleRate) / sampleRate;  // ~8 Hz flutter
-    const float driftInc = 0.05f / sampleRate;                      // Very slow drift
+    // Below the BS.1770 absolute gate there's nothing meaningful to match
+    constexpr float minimumLufs = -70.0f;
+    if (in.shortTerm < minimumLufs || out.shortTerm < minimumLufs)
+        return false;
 
-    for (int ch = 0; ch < std::min(numChannels, 2); ++ch)
-    {
-        auto* data = buffer.getWritePointer(ch);
+    auto* parameter = apvts.getParameter(ParameterIDs::output);
+    const float currentDb = parameter->convertFrom0to1(parameter->getValue());
 
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float sample = data[i];
-
-            // Get smoothed values
-            const float bcAmount = bitcrushSmoothed.getNextValue() / 100.0f * ageMult;
-            const float dsAmount = downsampleSmoothed.getNextValue() / 100.0f * ageMult;
-            const float noiseAmount = noiseSmoothed.getNextValue() / 100.0f * ageMult * mc.hissAmount;
-            const float wobAmount = wobbleSmoothed.getNextValue() / 100.0f * mc.wobbleDepth * ageMult;
-            const float satAmount = saturationSmoothed.getNextValue() / 100.0f * ageMult;
-
-            // =====================================================
-            // STAGE 1: BITCRUSHING
-            // =====================================================
-            if (bcAmount > 0.01f)
-            {
-                // Map 0-1 to 24-bit down to 2-bit
-                const float bits = 24.0f - bcAmount * 22.0f;
-                const float levels = std::pow(2.0f, bits);
-                sample = std::round(sample * levels) / levels;
-
-                // Add slight noise at low bit depths
-                if (bits < 8.0f)
-                {
-                    sample += noiseDist(noiseGen) * 0.002f * (8.0f - bits);
-                }
-            }
-
-            // =====================================================
-            // STAGE 2: SAMPLE RATE REDUCTION
-            // =====================================================
-            if (dsAmount > 0.01f)
-            {
-                // Map 0-1 to factor 1-64
-                const float factor = 1.0f + dsAmount * 63.0f;
-                sampleHoldCounter[ch] += 1.0f;
-
-                if (sampleHoldCounter[ch] >= factor)
-                {
-                    lastSample[ch] = sample;
-                    sampleHoldCounter[ch] -= factor;
-                }
-                sample = lastSample[ch];
-            }
-
-            // =====================================================
-            // STAGE 3: WOW & FLUTTER (Pitch Modulation)
-            // =====================================================
-            if (wobAmount > 0.01f)
-            {
-                // Wow: slow sine
-                const float wow = std::sin(wowPhase * juce::MathConstants<float>::twoPi) * wobAmount * 15.0f;
-                // Flutter: faster, irregular
-                const float flutter = std::sin(flutterPhase * juce::MathConstants<float>::twoPi * 3.0f) * wobAmount * 5.0f;
-                // Drift: very slow random-ish
-                const float drift = std::sin(driftPhase * juce::MathConstants<float>::twoPi * 0.1f) * wobAmount * 3.0f;
-
-                const float totalMod = wow + flutter + drift;
-
-                // Write to delay line
-                delayLine[ch][delayWritePos] = sample;
-
-                // Calculate modulated read position
-                const float baseDelay = 512.0f;
-                const float modDelay = baseDelay + totalMod;
-                modulatedDelay[ch] = modDelay;
-
-                // Linear interpolation read
-                const float readPosFloat = static_cast<float>(delayWritePos) - modDelay;
-                int readPos = static_cast<int>(std::floor(readPosFloat));
-                const float frac = readPosFloat - static_cast<float>(readPos);
-
-                // Wrap
-                while (readPos < 0) readPos += kMaxDelaySize;
-                readPos = readPos % kMaxDelaySize;
-                const int readPosNext = (readPos + 1) % kMaxDelaySize;
-
-                sample = delayLine[ch][readPos] * (1.0f - frac) + delayLine[ch][readPosNext] * frac;
-            }
-            else
-            {
-                // Still write to delay line for consistency
-                delayLine[ch][delayWritePos] = sample;
-            }
-
-            // =====================================================
-            // STAGE 4: SATURATION (Mode-dependent)
-            // =====================================================
-            if (satAmount > 0.01f)
-            {
-                const float drive = 1.0f + satAmount * 5.0f;
-                float driven = sample * drive;
-
-                // Mode-dependent saturation curve
-                switch (modeVal)
-                {
-                    case 0: // Cassette: warm tape saturation
-                    {
-                        driven = std::tanh(driven * 1.5f);
-                        // Even harmonics for warmth
-                        driven += 0.1f * satAmount * driven * std::abs(driven);
-                        break;
-                    }
-                    case 1: // Vinyl: gentle compression
-                    {
-                        driven = driven / (1.0f + std::abs(driven) * 0.5f);
-                        break;
-                    }
-                    case 2: // VHS: harsh, gritty
-                    {
-                        // Asymmetric clipping
-                        if (driven > 0.7f) driven = 0.7f + (driven - 0.7f) * 0.2f;
-                        if (driven < -0.5f) driven = -0.5f + (driven + 0.5f) * 0.3f;
-                        driven = std::tanh(driven * 2.0f);
-                        break;
-                    }
-                    case 3: // Radio: hard limiting
-                    {
-                        driven = std::clamp(driven, -0.8f, 0.8f);
-                        driven = std::tanh(driven * 2.5f);
-                        break;
-                    }
-                }
-
-                // Makeup gain
-                sample = driven * (1.0f / drive);
-            }
-
-            // =====================================================
-            // STAGE 5: DROPOUT (Tape/VHS)
-            // =====================================================
-            if (dropoutVal > 0.01f && (modeVal == 0 || modeVal == 2))
-            {
-                // Random dropout trigger
-                if (!inDropout && crackleChance(noiseGen) < dropoutVal * 0.0001f * ageMult)
-                {
-                    inDropout = true;
-                    dropoutTimer = 0.0f;
-                }
-
-                if (inDropout)
-                {
-                    dropoutTimer += 1.0f;
-                    const float dropoutLength = 50.0f + crackleChance(noiseGen) * 500.0f;
-
-                    if (dropoutTimer < dropoutLength)
-                    {
-                        // Quick fade out, slow fade in
-                        if (dropoutTimer < 10.0f)
-                            dropoutEnvelope = 1.0f - (dropoutTimer / 10.0f);
-                        else if (dropoutTimer > dropoutLength - 50.0f)
-                            dropoutEnvelope = (dropoutTimer - (dropoutLength - 50.0f)) / 50.0f;
-                        else
-                            dropoutEnvelope = 0.0f;
-                    }
-                    else
-                    {
-                        inDropout = false;
-                        dropoutEnvelope = 1.0f;
-                    }
-                }
-
-                sample *= dropoutEnvelope;
-            }
-
-            // =====================================================
-            // STAGE 6: NOISE & HISS
-            // =====================================================
-            if (noiseAmount > 0.001f)
-            {
-                float noiseOut = 0.0f;
-
-                // Generate colored noise based on mode
-                if (mc.noiseColor < 0.5f)
-                {
-                    // Pink-ish noise (filtered white)
-                    noiseOut = noiseDist(noiseGen);
-                    // Simple 1-pole lowpass for pink approximation
-                    static float pinkState[2] = { 0.0f, 0.0f };
-                    pinkState[ch] = pinkState[ch] * 0.9f + noiseOut * 0.1f;
-                    noiseOut = pinkState[ch] * 3.0f;
-                }
-                else
-                {
-                    // White noise
-                    noiseOut = noiseDist(noiseGen);
-                }
-
-                sample += noiseOut * noiseAmount * 0.05f;
-            }
-
-            // =====================================================
-            // STAGE 7: CRACKLE & POPS (Vinyl mode)
-            // =====================================================
-            if (crackleVal > 0.01f)
-            {
-                // Random crackle trigger
-                if (crackleChance(noiseGen) < crackleVal * 0.002f * ageMult)
-                {
-                    // Generate a pop
-                    crackleEnvelope[ch] = 0.3f + crackleChance(noiseGen) * 0.7f;
-                    crackleEnvelope[ch] *= (crackleChance(noiseGen) > 0.5f ? 1.0f : -1.0f);
-                }
-
-                // Decay crackle
-                crackleEnvelope[ch] *= 0.85f;
-
-                sample += crackleEnvelope[ch] * crackleVal / 100.0f;
-                crackleActivity.store(std::abs(crackleEnvelope[ch]));
-            }
-
-            // =====================================================
-            // STAGE 8: DC BLOCKING
-            // =====================================================
-            const float dcInput = sample;
-            sample = sample - dcState[ch];
-            dcState[ch] = dcInput * (1.0f - dcCoeff);
-
-            data[i] = sample;
-        }
+    parameter->beginChangeGesture();
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(currentDb + in.shortTerm - out.shortTerm));
+    parameter->endChangeGesture();
+    return true;
+}
+
+void OxideAudioProcessor::setVisualizerFrameRate(int hz)
+{
+    // Snap to the supported budgets
+    const int rate = hz <= 15 ? 15 : (hz <= 30 ? 30 : 60);
+    visualizerFrameRate.store(rate);
+}
+
+ParameterSnapshot OxideAudioProcessor::readParameters()
+{
+    // Seqlock-style read: if a preset switch started or finished while we were
+    // reading the host parameters, use the snapshot it published instead, so a
+    // block never mixes values from two presets.
+    const auto generationBefore = presetGeneration.load(std::memory_order_acquire);
+    auto snapshot = ParameterSnapshot::capture(apvts);
+    const auto generationAfter = presetGeneration.load(std::memory_order_acquire);
+
+    if ((generationBefore & 1u) != 0 || generationBefore != generationAfter)
+    {
+        presetSnapshot.acquire();
+        return presetSnapshot.getReadBuffer();
     }
 
-    // Advance delay write position (once per block for both channels)
-    delayWritePos = (delayWritePos + numSamples) % kMaxDelaySize;
+    // A coherent set: hand it to state saves too
+    auto& published = publishedParameters.getWriteBuffer();
+    published.params = snapshot;
+    published.generation = generationBefore;
+    published.blockTimeMs = juce::Time::getMillisecondCounter();
+    published.valid = true;
+    publishedParameters.publish();
 
-    // Advance LFO phases
-    wowPhase += wowInc * static_cast<float>(numSamples);
-    if (wowPhase >= 1.0f) wowPhase -= 1.0f;
-    flutterPhase += flutterInc * static_cast<float>(numSamples);
-    if (flutterPhase >= 1.0f) flutterPhase -= 1.0f;
-    driftPhase += driftInc * static_cast<float>(numSamples);
-    if (driftPhase >= 1.0f) driftPhase -= 1.0f;
+    return snapshot;
+}
 
-    wobblePhaseVis.store(wowPhase);
+void OxideAudioProcessor::setCurrentProgram(int index)
+{
+    const auto presets = presetBank.getPresets();
+    if (! juce::isPositiveAndBelow(index, static_cast<int>(presets->size())))
+        return;
 
-    // =========================================================================
-    // STAGE 9: FILTERING
-    // =========================================================================
-    const float cutoffNorm = filterCutoffSmoothed.getNextValue() / 100.0f;
-    const float resNorm = filterResVal / 100.0f;
-    const float driveNorm = filterDriveVal / 100.0f;
+    applySnapshot((*presets)[static_cast<size_t>(index)].snapshot);
 
-    // Map cutoff 0-1 to 200Hz - 20kHz with mode influence
-    float cutoffFreq = 200.0f * std::pow(100.0f, cutoffNorm);
-    cutoffFreq = std::min(cutoffFreq, mc.lpFreq);
+    currentProgram.store(index);
+    updateHostDisplay(juce::AudioProcessorListener::ChangeDetails().withProgramChanged(true));
+}
 
-    lowpassFilter.setCutoffFrequency(cutoffFreq);
-    lowpassFilter.setResonance(0.5f + resNorm * 9.5f);
+void OxideAudioProcessor::applySnapshot(const ParameterSnapshot& snapshot)
+{
+    // A state loaded on another thread lands first, so this one wins
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        handleUpdateNowIfNeeded();
 
-    // Apply filter drive (pre-filter saturation)
-    if (driveNorm > 0.01f)
     {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            auto* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i)
-            {
-                const float drive = 1.0f + driveNorm * 10.0f;
-                data[i] = std::tanh(data[i] * drive) / drive;
-            }
-        }
+        const auto sl = lockState();
+        beginSnapshot(snapshot);
     }
 
-    // Apply lowpass
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    lowpassFilter.process(context);
+    snapshot.applyTo(apvts);
+
+    const auto sl = lockState();
+    endSnapshots(1);
+}
+
+void OxideAudioProcessor::beginSnapshot(const ParameterSnapshot& snapshot)
+{
+    // Audio thread sees the complete snapshot first; no ValueTree work, no allocation
+    latestSnapshot = snapshot;
+    presetSnapshot.getWriteBuffer() = snapshot;
+    presetSnapshot.publish();
+
+    if (openSnapshots++ == 0)
+        presetGeneration.fetch_add(1);
+}
+
+void OxideAudioProcessor::endSnapshots(int count)
+{
+    openSnapshots -= count;
+    jassert(openSnapshots >= 0);
+
+    if (openSnapshots == 0)
+        presetGeneration.fetch_add(1);
+}
+
+void OxideAudioProcessor::handleAsyncUpdate()
+{
+    ParameterSnapshot loaded;
+    int numLoads = 0;
 
-    // Mode-specific filtering
-    if (modeVal == 3) // Radio mode: additional bandpass
     {
-        highpassFilter.setCutoffFrequency(mc.hpFreq);
-        highpassFilter.process(context);
+        const auto sl = lockState();
+        numLoads = pendingLoads;
+        pendingLoads = 0;
+        loaded = latestSnapshot;
     }
-    else
+
+    if (numLoads == 0)
+        return;
+
+    loaded.applyTo(apvts);
+
+    const auto sl = lockState();
+    endSnapshots(numLoads);
+}
+
+const juce::String OxideAudioProcessor::getProgramName(int index)
+{
+    const auto presets = presetBank.getPresets();
+    if (! juce::isPositiveAndBelow(index, static_cast<int>(presets->size())))
+        return {};
+
+    return (*presets)[static_cast<size_t>(index)].name;
+}
+
+int OxideAudioProcessor::saveUserPreset(const juce::String& name)
+{
+    const int index = presetBank.saveUserPreset(name, ParameterSnapshot::capture(apvts));
+    currentProgram.store(index);
+    updateHostDisplay(juce::AudioProcessorListener::ChangeDetails().withProgramChanged(true));
+    return index;
+}
+
+void OxideAudioProcessor::reloadUserPresets()
+{
+    if (presetBank.reloadUserBank())
+        updateHostDisplay(juce::AudioProcessorListener::ChangeDetails().withProgramChanged(true));
+}
+
+juce::AudioProcessorEditor* OxideAudioProcessor::createEditor()
+{
+#if OXIDE_HEADLESS
+    return nullptr;     // command-line builds (OxideRender) have no UI
+#else
+    if (usesNativeEditor())
+        return new OxideNativeEditor(*this);
+
+    return new OxideAudioProcessorEditor(*this);
+#endif
+}
+
+// =============================================================================
+// STATE
+//
+// Binary layout (version 2+), little-endian:
+//     uint32  magic ('OXST')
+//     uint32  state version
+//     int32   visualizer frame rate
+//     int32   current program
+//     uint32  number of columns (C)
+//     uint32  column index: parameter ID hash for each column
+//     float   current values[C], morph A[C], morph B[C]
+//     int32   native editor flag (version 3+)
+//
+// Columns are matched by ID hash, so states from builds with more or fewer
+// parameters still load. Version 1 states (XML) are still read.
+//
+// SESSION STATE
+//
+// Hosts save and restore from whatever thread suits them, often mid-playback.
+// Neither direction goes near the parameter tree's ValueTree or its locks:
+// saving takes the values the audio thread published for its last block (or
+// reads the parameter atomics if audio isn't running), and loading publishes
+// the new values to the audio thread through presetSnapshot, exactly like a
+// preset switch, leaving only the host-facing update for the message thread.
+// =============================================================================
+
+juce::ScopedLock OxideAudioProcessor::lockState()
+{
+    // A priority inversion waiting to happen: count it even in release builds,
+    // so the stress test catches it whatever it was built as
+    if (juce::Thread::getCurrentThreadId() == audioThread.load(std::memory_order_relaxed))
     {
-        // Light high-pass for other modes
-        highpassFilter.setCutoffFrequency(mc.hpFreq);
-        highpassFilter.process(context);
+        ++stateLockOnAudioThread;
+        jassertfalse;
     }
 
-    // =========================================================================
-    // STAGE 10: DRY/WET MIX
-    // =========================================================================
-    const float mixNorm = mixSmoothed.getNextValue() / 100.0f;
+    return juce::ScopedLock(stateLock);
+}
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer(ch);
-        const auto* dry = dryBuffer.getReadPointer(ch);
+OxideAudioProcessor::SessionState OxideAudioProcessor::captureSessionState()
+{
+    const auto sl = lockState();
 
-        for (int i = 0; i < numSamples; ++i)
-        {
-            wet[i] = wet[i] * mixNorm + dry[i] * (1.0f - mixNorm);
-        }
+    SessionState state;
+    state.morph = morphSlots;
+
+    if (openSnapshots > 0)
+    {
+        // A preset switch or load is still on its way to the host parameters
+        state.current = latestSnapshot;
+        return state;
     }
 
-    // =========================================================================
-    // STAGE 11: OUTPUT GAIN
-    // =========================================================================
-    const float outputGain = juce::Decibels::decibelsToGain(outputVal);
-    buffer.applyGain(outputGain);
+    publishedParameters.acquire();
+    const auto& published = publishedParameters.getReadBuffer();
+
+    const bool audioIsCurrent = published.valid
+        && published.generation == presetGeneration.load(std::memory_order_acquire)
+        && juce::Time::getMillisecondCounter() - published.blockTimeMs <= kPublishedParametersMaxAgeMs;
+
+    state.current = audioIsCurrent ? published.params : ParameterSnapshot::capture(apvts);
+    return state;
 }
 
-juce::AudioProcessorEditor* OxideAudioProcessor::createEditor()
+void OxideAudioProcessor::loadSessionState(const SessionState& state)
 {
-    return new OxideAudioProcessorEditor(*this);
+    {
+        const auto sl = lockState();
+        morphSlots = state.morph;
+        publishMorphSnapshots();
+
+        // The audio thread plays the loaded values from its next block
+        beginSnapshot(state.current);
+        ++pendingLoads;
+    }
+
+    // The host parameters notify listeners, so they're only set on the message thread
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        handleAsyncUpdate();
+    else
+        triggerAsyncUpdate();
 }
 
 void OxideAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    state.setProperty("stateVersion", kStateVersion, nullptr);
+    const auto state = captureSessionState();
+
+    juce::MemoryOutputStream out(destData, false);
+    out.writeInt(static_cast<int>(kStateMagic));
+    out.writeInt(kStateVersion);
+    out.writeInt(getVisualizerFrameRate());
+    out.writeInt(getCurrentProgram());
+    out.writeInt(ParameterIDs::numParameters);
 
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    for (auto* id : ParameterIDs::all)
+        out.writeInt(static_cast<int>(hashParameterID(id)));
+
+    const ParameterSnapshot* sections[] = { &state.current, &state.morph.a, &state.morph.b };
+    for (const auto* snapshot : sections)
+        for (float value : snapshot->values)
+            out.writeFloat(value);
+
+    out.writeInt(usesNativeEditor() ? 1 : 0);
 }
 
 void OxideAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
+    // Parameters missing from the state keep their current values
+    auto state = captureSessionState();
+    bool loaded = false;
 
-    if (xml != nullptr && xml->hasTagName(apvts.state.getType()))
+    juce::MemoryInputStream in(data, static_cast<size_t>(juce::jmax(0, sizeInBytes)), false);
+
+    if (sizeInBytes >= 8 && static_cast<std::uint32_t>(in.readInt()) == kStateMagic)
+    {
+        loaded = readBinaryState(in, state);
+        if (! loaded)
+            DBG("Ignoring malformed binary state");
+    }
+    else
     {
-        auto newState = juce::ValueTree::fromXml(*xml);
+        loaded = readLegacyXmlState(data, sizeInBytes, state);
+    }
+
+    if (loaded)
+        loadSessionState(state);
+}
+
+bool OxideAudioProcessor::readBinaryState(juce::MemoryInputStream& in, SessionState& state)
+{
+    const int version = in.readInt();
+    const int frameRate = in.readInt();
+    const int program = in.readInt();
+    const int numColumns = in.readInt();
+
+    if (version < 2 || numColumns <= 0 || in.getNumBytesRemaining() < static_cast<juce::int64>(numColumns) * 4 * 4)
+        return false;
+
+    if (version > kStateVersion)
+        DBG("State is from a newer version (" + juce::String(version) + "), loading known parameters only");
 
-        int version = newState.getProperty("stateVersion", 0);
-        if (version < kStateVersion)
+    // Column index: where each stored value goes in our parameter order
+    std::vector<int> columnTarget(static_cast<size_t>(numColumns));
+    for (auto& target : columnTarget)
+        target = findParameterIndex(static_cast<std::uint32_t>(in.readInt()));
+
+    ParameterSnapshot* sections[] = { &state.current, &state.morph.a, &state.morph.b };
+    for (auto* snapshot : sections)
+    {
+        for (int target : columnTarget)
         {
-            DBG("Migrating state from version " + juce::String(version) + " to " + juce::String(kStateVersion));
+            const float value = in.readFloat();
+            if (target >= 0)
+                (*snapshot)[target] = value;
         }
+    }
+
+    // Older states keep whatever this build defaults to
+    if (version >= 3 && in.getNumBytesRemaining() >= 4)
+        setUsesNativeEditor(in.readInt() != 0);
+
+    setVisualizerFrameRate(frameRate);
+    currentProgram.store(juce::jlimit(0, getNumPrograms() - 1, program));
+    return true;
+}
+
+bool OxideAudioProcessor::readLegacyXmlState(const void* data, int sizeInBytes, SessionState& state)
+{
+    // The old format was the parameter tree itself: read it as XML rather than
+    // going through replaceState, so it loads like any other state
+    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
+
+    if (xml == nullptr || ! xml->hasTagName(apvts.state.getType().toString()))
+        return false;
 
-        apvts.replaceState(newState);
+    const int version = xml->getIntAttribute("stateVersion", 0);
+    if (version < kStateVersion)
+    {
+        DBG("Migrating state from version " + juce::String(version) + " to " + juce::String(kStateVersion));
+    }
+
+    for (auto* param : xml->getChildWithTagNameIterator("PARAM"))
+    {
+        const int index = findParameterIndex(hashParameterID(param->getStringAttribute("id").toRawUTF8()));
+        if (index >= 0)
+            state.current[index] = static_cast<float>(param->getDoubleAttribute("value", state.current[index]));
+    }
+
+    if (auto* morphState = xml->getChildByName("MORPH"))
+    {
+        for (int slot = 0; slot < 2; ++slot)
+        {
+            auto& snapshot = slot == 0 ? state.morph.a : state.morph.b;
+            if (auto* slotState = morphState->getChildByName(slot == 0 ? "A" : "B"))
+                for (int i = 0; i < ParameterIDs::numParameters; ++i)
+                    snapshot[i] = static_cast<float>(slotState->getDoubleAttribute(ParameterIDs::all[i], snapshot[i]));
+        }
     }
+
+    setVisualizerFrameRate(xml->getIntAttribute("visualizerRate", 60));
+    currentProgram.store(juce::jlimit(0, getNumPrograms() - 1, xml->getIntAttribute("currentProgram", 0)));
+    return true;
 }
 
+#if ! OXIDE_HEADLESS
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
     return new OxideAudioProcessor();
 }
+#endif
@@ -2,7 +2,14 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
-#include <random>
+#include "OxideDsp.h"
+#include "LoudnessMeter.h"
+#include "ParameterSnapshot.h"
+#include "PerformanceTelemetry.h"
+#include "PresetBank.h"
+#include "SnapshotBuffer.h"
+#include "Trace.h"
+#include "WaveformHistory.h"
 
 #if HAS_PROJECT_DATA
 #include "ProjectData.h"
@@ -12,7 +19,13 @@
 #include <beatconnect/Activation.h>
 #endif
 
-class OxideAudioProcessor : public juce::AudioProcessor
+// Build option: open the native editor rather than the web UI unless the session says otherwise
+#ifndef OXIDE_NATIVE_EDITOR_DEFAULT
+#define OXIDE_NATIVE_EDITOR_DEFAULT 0
+#endif
+
+class OxideAudioProcessor : public juce::AudioProcessor,
+                            private juce::AsyncUpdater
 {
 public:
     OxideAudioProcessor();
@@ -22,35 +35,82 @@ public:
     void releaseResources() override;
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
+#if OXIDE_HEADLESS
+    bool hasEditor() const override { return false; }
+#else
     bool hasEditor() const override { return true; }
+#endif
 
     const juce::String getName() const override { return JucePlugin_Name; }
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.1; }
+    double getTailLengthSeconds() const override;
 
-    int getNumPrograms() override { return 1; }
-    int getCurrentProgram() override { return 0; }
-    void setCurrentProgram(int) override {}
-    const juce::String getProgramName(int) override { return {}; }
+    int getNumPrograms() override { return juce::jmax(1, presetBank.getNumPresets()); }
+    int getCurrentProgram() override { return currentProgram.load(); }
+    void setCurrentProgram(int index) override;
+    const juce::String getProgramName(int index) override;
     void changeProgramName(int, const juce::String&) override {}
 
+    // Presets (message thread)
+    const PresetBank& getPresetBank() const { return presetBank; }
+    int saveUserPreset(const juce::String& name);
+    void reloadUserPresets();   // picks up presets other instances saved (tells the host if any)
+
+    // Morph (message thread): capture the current sound into slot 0 (A) or 1 (B)
+    void storeMorphSnapshot(int slot);
+
+    // Session state: any thread, never blocks the audio thread (see SESSION STATE below)
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+    /** Message thread: pushes a state loaded on another thread to the host parameters
+        now, rather than on the next message-loop pass (for tools that run no loop). */
+    void applyPendingState() { handleUpdateNowIfNeeded(); }
+
+    /** How many times the session-state lock was taken on the (realtime) audio
+        thread; always 0 unless something is wrong. Checked by OxideRender --state-stress. */
+    int getStateLockAudioThreadCount() const { return stateLockOnAudioThread.load(); }
+
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
     // Visualizer data access (thread-safe)
-    float getCurrentRMS() const { return currentRMS.load(); }
-    float getCurrentPeak() const { return currentPeak.load(); }
-    float getWobblePhase() const { return wobblePhaseVis.load(); }
-    float getCrackleActivity() const { return crackleActivity.load(); }
-    int getCurrentMode() const { return currentMode.load(); }
-    bool isBypassed() const { return bypassed.load(); }
-    float getDegradationAmount() const { return degradationAmount.load(); }
+    float getCurrentRMS() const { return meters.rms.load(); }
+    float getCurrentPeak() const { return meters.peak.load(); }
+    float getWobblePhase() const { return meters.wobblePhase.load(); }
+    float getCrackleActivity() const { return meters.crackleActivity.load(); }
+    int getCurrentMode() const { return meters.mode.load(); }
+    bool isBypassed() const { return meters.bypassed.load(); }
+    float getDegradationAmount() const { return meters.degradation.load(); }
+
+    // BS.1770 loudness and true peak of the input and output, measured off the audio thread
+    const LoudnessMeter& getLoudness() const { return loudness; }
+    void resetLoudness() { loudness.requestReset(); }
+
+    // Level matching (message thread): moves the output gain by the short-term
+    // loudness difference between input and output. False while either is too quiet.
+    bool matchOutputLoudness();
+
+    // Decimated input/output waveform for the visualizer (enabled by the editor while it draws)
+    WaveformHistory& getWaveformHistory() { return waveform; }
+
+    // Visualizer frame budget (15/30/60 Hz), chosen in the UI and saved with the session
+    int getVisualizerFrameRate() const { return visualizerFrameRate.load(); }
+    void setVisualizerFrameRate(int hz);
+
+    // Editor choice: the native JUCE editor instead of the web UI. Saved with the
+    // session; takes effect the next time the host opens the editor.
+    bool usesNativeEditor() const { return nativeEditor.load(); }
+    void setUsesNativeEditor(bool shouldUseNative) { nativeEditor.store(shouldUseNative); }
+
+    // Deadline telemetry for processBlock (readable from any thread, including headless hosts)
+    const PerformanceTelemetry& getTelemetry() const { return telemetry; }
+    void resetTelemetry() { telemetry.requestReset(); }
 
     // BeatConnect integration
     bool hasActivationEnabled() const;
@@ -65,87 +125,108 @@ public:
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     void loadProjectData();
-    void updateModeCharacteristics(int mode);
+    ParameterSnapshot readParameters();
+    void publishMorphSnapshots();
+    void applySnapshot(const ParameterSnapshot& snapshot);
+    void beginSnapshot(const ParameterSnapshot& snapshot);
+    void endSnapshots(int count);
+    void handleAsyncUpdate() override;
+
+    struct MorphPair
+    {
+        ParameterSnapshot a;
+        ParameterSnapshot b;
+    };
+
+    // Everything a saved session holds besides the plain settings
+    struct SessionState
+    {
+        ParameterSnapshot current;
+        MorphPair morph;
+    };
+
+    SessionState captureSessionState();
+    void loadSessionState(const SessionState& state);
+    bool readBinaryState(juce::MemoryInputStream& in, SessionState& state);
+    bool readLegacyXmlState(const void* data, int sizeInBytes, SessionState& state);
+
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, OxideDsp<SampleType>& dsp);
 
     juce::AudioProcessorValueTreeState apvts;
 
-    // === DSP Components ===
-
-    // Bitcrusher state
-    float bitcrushHold[2] = { 0.0f, 0.0f };
-    int bitcrushCounter[2] = { 0, 0 };
-
-    // Sample rate reduction
-    float lastSample[2] = { 0.0f, 0.0f };
-    float sampleHoldCounter[2] = { 0.0f, 0.0f };
-
-    // Noise generator
-    std::mt19937 noiseGen;
-    std::uniform_real_distribution<float> noiseDist { -1.0f, 1.0f };
-    std::uniform_real_distribution<float> crackleChance { 0.0f, 1.0f };
-
-    // Wow & flutter LFOs
-    float wowPhase = 0.0f;
-    float flutterPhase = 0.0f;
-    float driftPhase = 0.0f;
-
-    // Pitch shifting delay line for wow/flutter
-    static constexpr int kMaxDelaySize = 4096;
-    float delayLine[2][kMaxDelaySize] = {};
-    int delayWritePos = 0;
-    float modulatedDelay[2] = { 0.0f, 0.0f };
-
-    // Dropout simulation
-    float dropoutEnvelope = 1.0f;
-    float dropoutTimer = 0.0f;
-    bool inDropout = false;
-
-    // Crackle state
-    float crackleEnvelope[2] = { 0.0f, 0.0f };
-    int crackleTimer = 0;
-
-    // Filters
-    juce::dsp::StateVariableTPTFilter<float> lowpassFilter;
-    juce::dsp::StateVariableTPTFilter<float> highpassFilter;  // For radio mode
-    juce::dsp::StateVariableTPTFilter<float> bandpassFilter;  // For radio mode
-    juce::dsp::StateVariableTPTFilter<float> tapeHeadFilter;  // Tape head bump
-
-    // DC blocker
-    float dcState[2] = { 0.0f, 0.0f };
-    float dcCoeff = 0.995f;
-
-    // Smoothed parameters
-    juce::SmoothedValue<float> bitcrushSmoothed;
-    juce::SmoothedValue<float> downsampleSmoothed;
-    juce::SmoothedValue<float> noiseSmoothed;
-    juce::SmoothedValue<float> wobbleSmoothed;
-    juce::SmoothedValue<float> saturationSmoothed;
-    juce::SmoothedValue<float> filterCutoffSmoothed;
-    juce::SmoothedValue<float> mixSmoothed;
-
-    // Mode-specific characteristics
-    struct ModeChar {
-        float noiseColor = 1.0f;      // 0=pink, 1=white, 0.5=tape
-        float wobbleDepth = 1.0f;     // Pitch modulation depth
-        float wobbleRate = 1.0f;      // Pitch modulation rate
-        float satCurve = 0.5f;        // Saturation curve type
-        float hpFreq = 20.0f;         // High-pass frequency
-        float lpFreq = 20000.0f;      // Low-pass frequency
-        float hissAmount = 1.0f;      // Noise character
+    // === Presets ===
+    PresetBank presetBank;
+    std::atomic<int> currentProgram { 0 };
+
+    // A preset switch or state load publishes its whole snapshot here before
+    // updating the host parameters; the generation is odd while any such update
+    // is in progress. Written under stateLock, read every block: on its own cache line.
+    SnapshotBuffer<ParameterSnapshot> presetSnapshot;
+    alignas(64) std::atomic<juce::uint32> presetGeneration { 0 };
+
+    // === Morph ===
+    MorphPair morphSlots;                        // message-side copy (stateLock)
+    SnapshotBuffer<MorphPair> morphSnapshots;    // handed to the audio thread
+
+    // === Session state ===
+    // Coherent parameter values the audio thread read for its last block, for state
+    // saves; stale once the audio stops, when saves read the parameters directly
+    struct PublishedParameters
+    {
+        ParameterSnapshot params;
+        juce::uint32 generation = 0;             // presetGeneration they were read under
+        juce::uint32 blockTimeMs = 0;
+        bool valid = false;
     };
-    ModeChar modeChars[4];  // Cassette, Vinyl, VHS, Radio
-    int lastMode = -1;
+    SnapshotBuffer<PublishedParameters> publishedParameters;
+    static constexpr juce::uint32 kPublishedParametersMaxAgeMs = 250;
+
+    // Serialises the message-side writers (morph slots, presetSnapshot, loads
+    // from host threads) and the state savers. Never taken by the audio thread:
+    // always go through lockState(), which checks (and counts) that in every build.
+    juce::CriticalSection stateLock;
+    juce::ScopedLock lockState();
+    std::atomic<juce::Thread::ThreadID> audioThread { nullptr };   // last realtime process() caller
+    std::atomic<int> stateLockOnAudioThread { 0 };
+    int openSnapshots = 0;                       // published but not yet on the host parameters
+    int pendingLoads = 0;                        // ... of which loads waiting for the message thread
+    ParameterSnapshot latestSnapshot;            // the last one published
+
+    // === DSP ===
+    // One core per precision; only the one matching the host is prepared
+    OxideDsp<float> floatDsp;
+    OxideDsp<double> doubleDsp;
+
+    // Visualizer data, written by the audio thread once per block and polled by the
+    // editor. Padded to its own cache line so the editor's reads never share a line
+    // with DSP state or with values the message thread writes.
+    struct alignas(64) VisualizerMeters
+    {
+        std::atomic<float> rms { 0.0f };
+        std::atomic<float> peak { 0.0f };
+        std::atomic<float> wobblePhase { 0.0f };
+        std::atomic<float> crackleActivity { 0.0f };
+        std::atomic<int> mode { 0 };
+        std::atomic<bool> bypassed { false };
+        std::atomic<float> degradation { 0.0f };
+    };
+    VisualizerMeters meters;
+    WaveformHistory waveform;
+    LoudnessMeter loudness;
+
+    // Message thread only (saved with the session)
+    alignas(64) std::atomic<int> visualizerFrameRate { 60 };
+    std::atomic<bool> nativeEditor { OXIDE_NATIVE_EDITOR_DEFAULT != 0 };
 
-    // Visualizer data (atomic for thread safety)
-    std::atomic<float> currentRMS { 0.0f };
-    std::atomic<float> currentPeak { 0.0f };
-    std::atomic<float> wobblePhaseVis { 0.0f };
-    std::atomic<float> crackleActivity { 0.0f };
-    std::atomic<int> currentMode { 0 };
-    std::atomic<bool> bypassed { false };
-    std::atomic<float> degradationAmount { 0.0f };
+    // Block timing; the configuration is set by process() for the block being timed
+    PerformanceTelemetry telemetry;
+    int telemetryConfiguration = 0;
 
-    double currentSampleRate = 44100.0;
+#if OXIDE_ENABLE_TRACING
+    // Shared by every instance: one trace file while any of them is alive
+    juce::SharedResourcePointer<TraceSession> traceSession;
+#endif
 
     // BeatConnect data
     juce::String pluginId;
@@ -158,7 +239,8 @@ private:
 #endif
 
     // State version for backwards compatibility
-    static constexpr int kStateVersion = 1;
+    static constexpr int kStateVersion = 3;          // 1 = XML ValueTree, 2 = binary, 3 = + editor choice
+    static constexpr std::uint32_t kStateMagic = 0x5453584f; // 'OXST'
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OxideAudioProcessor)
 };
@@ -0,0 +1,233 @@
+#include "PresetBank.h"
+#include <algorithm>
+
+namespace
+{
+    struct FactoryPreset
+    {
+        const char* name;
+        const char* category;
+        // Native-range values in ParameterIDs::all order:
+        // bitcrush, downsample, noise, crackle, wobble, dropout, saturation, age,
+        // filterCutoff, filterRes, filterDrive, mode, mix, output, bypass, morph, morphOn,
+        // linkChannels, crushMode, satEngine, envAttack, envRelease, envMode, envToAge,
+        // envToNoise, envToSaturation, envToFilter
+        float values[ParameterIDs::numParameters];
+    };
+
+    constexpr FactoryPreset factoryPresets[] = {
+        { "Init",          "Default",  {  0.0f,  0.0f, 15.0f,  0.0f, 20.0f,  0.0f, 30.0f, 25.0f, 80.0f,  0.0f,  0.0f, 0.0f, 100.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "Dusty Vinyl",   "Vinyl",    {  0.0f,  0.0f, 10.0f, 45.0f, 10.0f,  0.0f, 25.0f, 50.0f, 70.0f,  5.0f,  0.0f, 1.0f, 100.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "Worn Cassette", "Cassette", {  0.0f,  5.0f, 30.0f,  0.0f, 45.0f, 20.0f, 40.0f, 55.0f, 65.0f, 10.0f, 10.0f, 0.0f, 100.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "VHS Memories",  "VHS",      { 10.0f, 15.0f, 25.0f,  0.0f, 60.0f, 25.0f, 45.0f, 60.0f, 50.0f, 15.0f, 15.0f, 2.0f, 100.0f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "AM Radio",      "Radio",    { 35.0f, 30.0f, 40.0f,  0.0f,  5.0f,  0.0f, 60.0f, 40.0f, 45.0f, 30.0f, 35.0f, 3.0f, 100.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "Lo-Fi Beats",   "Cassette", { 20.0f, 10.0f, 20.0f, 10.0f, 30.0f,  0.0f, 35.0f, 35.0f, 60.0f, 10.0f,  5.0f, 0.0f,  80.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "Old Record",    "Vinyl",    { 15.0f, 10.0f, 20.0f, 70.0f, 20.0f,  0.0f, 30.0f, 75.0f, 55.0f, 10.0f,  0.0f, 1.0f, 100.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "Tape Warble",   "Cassette", {  0.0f,  0.0f, 15.0f,  0.0f, 85.0f, 10.0f, 30.0f, 40.0f, 75.0f,  5.0f,  0.0f, 0.0f, 100.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "Broken TV",     "VHS",      { 45.0f, 40.0f, 50.0f, 10.0f, 70.0f, 60.0f, 55.0f, 90.0f, 40.0f, 20.0f, 40.0f, 2.0f, 100.0f, -2.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+        { "Subtle Warmth", "Cassette", {  0.0f,  0.0f,  5.0f,  0.0f,  8.0f,  0.0f, 35.0f, 10.0f, 90.0f,  0.0f, 10.0f, 0.0f,  60.0f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 10.0f, 200.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+    };
+
+    void writeFixedString(juce::MemoryOutputStream& out, const juce::String& text, int numBytes)
+    {
+        char buffer[64] = {};
+        jassert(numBytes <= static_cast<int>(sizeof(buffer)));
+        text.copyToUTF8(buffer, static_cast<size_t>(numBytes));   // always null-terminated
+        out.write(buffer, static_cast<size_t>(numBytes));
+    }
+
+    juce::String readFixedString(juce::MemoryInputStream& in, int numBytes)
+    {
+        char buffer[64] = {};
+        jassert(numBytes <= static_cast<int>(sizeof(buffer)));
+        in.read(buffer, numBytes);
+        buffer[numBytes - 1] = 0;
+        return juce::String::fromUTF8(buffer);
+    }
+}
+
+PresetBank::PresetBank()
+{
+    PresetList list;
+    addFactoryPresets(list);
+    readUserBank(getUserBankFile(), list);
+    presets = std::make_shared<const PresetList>(std::move(list));
+}
+
+juce::File PresetBank::getUserBankFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("BeatConnect")
+        .getChildFile("Oxide")
+        .getChildFile("UserPresets.oxpb");
+}
+
+ParameterSnapshot PresetBank::getDefaultSnapshot()
+{
+    ParameterSnapshot snapshot;
+    for (int i = 0; i < ParameterIDs::numParameters; ++i)
+        snapshot[i] = factoryPresets[0].values[i];
+    return snapshot;
+}
+
+void PresetBank::addFactoryPresets(PresetList& list)
+{
+    for (const auto& factory : factoryPresets)
+    {
+        Preset preset;
+        preset.name = factory.name;
+        preset.category = factory.category;
+        preset.isFactory = true;
+
+        for (int i = 0; i < ParameterIDs::numParameters; ++i)
+            preset.snapshot[i] = factory.values[i];
+
+        list.push_back(std::move(preset));
+    }
+
+    numFactoryPresets = static_cast<int>(list.size());
+}
+
+PresetBank::Preset PresetBank::getPreset(int index) const
+{
+    const auto list = getPresets();
+    return (*list)[static_cast<size_t>(juce::jlimit(0, static_cast<int>(list->size()) - 1, index))];
+}
+
+bool PresetBank::reloadUserBank()
+{
+    const juce::ScopedLock sl(userBankLock);
+    juce::InterProcessLock fileLock(kUserBankLockName);
+    if (! fileLock.enter(kUserBankLockTimeoutMs))
+        DBG("User preset bank is locked by another process; reading it anyway");
+
+    const auto current = getPresets();
+    PresetList list(current->begin(), current->begin() + numFactoryPresets);
+    readUserBank(getUserBankFile(), list);
+
+    const auto samePreset = [](const Preset& a, const Preset& b)
+    {
+        return a.name == b.name && a.category == b.category && a.snapshot.values == b.snapshot.values;
+    };
+
+    if (std::equal(list.begin(), list.end(), current->begin(), current->end(), samePreset))
+        return false;
+
+    std::atomic_store(&presets, std::make_shared<const PresetList>(std::move(list)));
+    return true;
+}
+
+int PresetBank::saveUserPreset(const juce::String& name, const ParameterSnapshot& snapshot)
+{
+    const juce::ScopedLock sl(userBankLock);
+    juce::InterProcessLock fileLock(kUserBankLockName);
+    if (! fileLock.enter(kUserBankLockTimeoutMs))
+        DBG("User preset bank is locked by another process; saving anyway");
+
+    // Start from what's on disk now rather than our copy, so presets other
+    // instances saved since we loaded survive (unless the file can't be read).
+    // Readers keep the old list until the new one is published.
+    const auto current = getPresets();
+    PresetList list(current->begin(), current->begin() + numFactoryPresets);
+    auto file = getUserBankFile();
+
+    if (! readUserBank(file, list) && file.existsAsFile())
+        list.assign(current->begin(), current->end());
+
+    int index = -1;
+    for (int i = numFactoryPresets; i < static_cast<int>(list.size()); ++i)
+        if (list[static_cast<size_t>(i)].name == name)
+            index = i;
+
+    if (index < 0)
+    {
+        Preset preset;
+        preset.name = name;
+        preset.category = "User";
+        list.push_back(std::move(preset));
+        index = static_cast<int>(list.size()) - 1;
+    }
+
+    list[static_cast<size_t>(index)].snapshot = snapshot;
+
+    file.getParentDirectory().createDirectory();
+    if (! writeUserBank(file, list))
+        DBG("Failed to write user preset bank: " + file.getFullPathName());
+
+    std::atomic_store(&presets, std::make_shared<const PresetList>(std::move(list)));
+    return index;
+}
+
+bool PresetBank::readUserBank(const juce::File& file, PresetList& list) const
+{
+    juce::MemoryBlock data;
+    if (! file.existsAsFile() || ! file.loadFileAsData(data))
+        return false;
+
+    juce::MemoryInputStream in(data, false);
+
+    if (static_cast<std::uint32_t>(in.readInt()) != kMagic)
+        return false;
+
+    const auto version = static_cast<std::uint32_t>(in.readInt());
+    const int numColumns = in.readInt();
+    const int numStored = in.readInt();
+
+    if (version > kFormatVersion || numColumns <= 0 || numStored < 0)
+        return false;
+
+    const auto recordSize = static_cast<juce::int64>(kNameBytes + kCategoryBytes + numColumns * 4);
+    if (in.getNumBytesRemaining() < numColumns * 4 + numStored * recordSize)
+        return false;
+
+    // Column index: where each stored value goes in our parameter order
+    std::vector<int> columnTarget(static_cast<size_t>(numColumns));
+    for (auto& target : columnTarget)
+        target = findParameterIndex(static_cast<std::uint32_t>(in.readInt()));
+
+    const auto defaults = getDefaultSnapshot();
+
+    for (int p = 0; p < numStored; ++p)
+    {
+        Preset preset;
+        preset.name = readFixedString(in, kNameBytes);
+        preset.category = readFixedString(in, kCategoryBytes);
+        preset.snapshot = defaults;
+
+        for (int target : columnTarget)
+        {
+            const float value = in.readFloat();
+            if (target >= 0)
+                preset.snapshot[target] = value;
+        }
+
+        list.push_back(std::move(preset));
+    }
+
+    return true;
+}
+
+bool PresetBank::writeUserBank(const juce::File& file, const PresetList& list) const
+{
+    juce::MemoryOutputStream out;
+
+    out.writeInt(static_cast<int>(kMagic));
+    out.writeInt(static_cast<int>(kFormatVersion));
+    out.writeInt(ParameterIDs::numParameters);
+    out.writeInt(static_cast<int>(list.size()) - numFactoryPresets);
+
+    for (auto* id : ParameterIDs::all)
+        out.writeInt(static_cast<int>(hashParameterID(id)));
+
+    for (size_t p = static_cast<size_t>(numFactoryPresets); p < list.size(); ++p)
+    {
+        const auto& preset = list[p];
+        writeFixedString(out, preset.name, kNameBytes);
+        writeFixedString(out, preset.category, kCategoryBytes);
+
+        for (float value : preset.snapshot.values)
+            out.writeFloat(value);
+    }
+
+    return file.replaceWithData(out.getData(), out.getDataSize());
+}
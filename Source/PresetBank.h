@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ParameterSnapshot.h"
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <memory>
+
+/**
+    Factory presets (compiled in) followed by the user bank (one binary file).
+
+    User bank file layout, little-endian:
+        uint32  magic ('OXPB')
+        uint32  format version
+        uint32  number of columns (C)
+        uint32  number of presets (N)
+        uint32  column index: parameter ID hash for each of the C columns
+        N fixed-size records: char name[32], char category[16], float values[C]
+
+    Columns are matched to parameters by ID hash, so banks written by older or
+    newer builds still load; parameters missing from the file keep their defaults.
+
+    Hosts query programs from any thread while the editor saves presets on the
+    message thread, so the list is never edited in place: writers build a new
+    list and publish it whole, and readers work on whichever list they got from
+    getPresets(). Iterate over one getPresets() rather than looping on
+    getNumPresets()/getPreset(), which may each see a different list.
+
+    Every instance (in this process or another, e.g. a sandboxed host) shares
+    the one file, so saving re-reads it under a file lock and merges into what
+    is there, rather than writing out this instance's copy over presets saved
+    elsewhere since it was loaded. reloadUserBank() picks those up.
+*/
+class PresetBank
+{
+public:
+    struct Preset
+    {
+        juce::String name;
+        juce::String category;
+        ParameterSnapshot snapshot;
+        bool isFactory = false;
+    };
+
+    using PresetList = std::vector<Preset>;
+
+    PresetBank();
+
+    // === Any thread ===
+    /** The current list; stays valid (and unchanged) for as long as it's held. */
+    std::shared_ptr<const PresetList> getPresets() const { return std::atomic_load(&presets); }
+
+    int getNumPresets() const { return static_cast<int>(getPresets()->size()); }
+    int getNumFactoryPresets() const { return numFactoryPresets; }
+    Preset getPreset(int index) const;
+
+    // === Message thread ===
+
+    /** Adds (or overwrites by name) a user preset in the bank on disk, then
+        publishes the merged bank. Returns its index. */
+    int saveUserPreset(const juce::String& name, const ParameterSnapshot& snapshot);
+
+    /** Reloads the user bank from disk, with presets other instances saved.
+        Returns true if the list changed. */
+    bool reloadUserBank();
+
+    static juce::File getUserBankFile();
+    static ParameterSnapshot getDefaultSnapshot();
+
+private:
+    void addFactoryPresets(PresetList& list);
+    bool readUserBank(const juce::File& file, PresetList& list) const;
+    bool writeUserBank(const juce::File& file, const PresetList& list) const;
+
+    std::shared_ptr<const PresetList> presets;   // swapped with std::atomic_load/store only
+    int numFactoryPresets = 0;
+
+    // Serialises reading and writing the file: the critical section between
+    // instances in this process (a file lock doesn't), the file lock between processes
+    static inline juce::CriticalSection userBankLock;
+    static constexpr const char* kUserBankLockName = "BeatConnectOxideUserPresets";
+    static constexpr int kUserBankLockTimeoutMs = 2000;
+
+    static constexpr std::uint32_t kMagic = 0x4250584f; // 'OXPB'
+    static constexpr std::uint32_t kFormatVersion = 1;
+    static constexpr int kNameBytes = 32;
+    static constexpr int kCategoryBytes = 16;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
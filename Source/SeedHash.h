@@ -0,0 +1,32 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+    Stateless hashing for position-derived randomness: the same key and index
+    always give the same value, so random sources can be evaluated at any
+    sample position without replaying everything before it.
+*/
+namespace SeedHash
+{
+    /** SplitMix64 finaliser: well-mixed 64 bits from any input. */
+    inline juce::uint64 mix(juce::uint64 x) noexcept
+    {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    /** Hash of a key and an index. */
+    inline juce::uint64 combine(juce::uint64 key, juce::int64 index) noexcept
+    {
+        return mix(key ^ mix(static_cast<juce::uint64>(index)));
+    }
+
+    /** Uniform value in [-1, 1) from a hash. */
+    inline float toBipolar(juce::uint64 hash) noexcept
+    {
+        return static_cast<float>(hash >> 40) * (2.0f / 16777216.0f) - 1.0f;
+    }
+}
@@ -0,0 +1,124 @@
+#include "SharedTables.h"
+
+template <typename SampleType>
+std::mutex SharedTables<SampleType>::registryLock;
+
+template <typename SampleType>
+std::map<int, std::weak_ptr<const SharedTables<SampleType>>> SharedTables<SampleType>::registry;
+
+template <typename SampleType>
+std::shared_ptr<const SharedTables<SampleType>> SharedTables<SampleType>::getFor(double sampleRate)
+{
+    const int key = juce::roundToInt(sampleRate);
+    const std::lock_guard<std::mutex> lock(registryLock);
+
+    auto& slot = registry[key];
+    if (auto existing = slot.lock())
+        return existing;
+
+    auto tables = std::make_shared<const SharedTables>(sampleRate);
+    slot = tables;
+
+    DBG("Built shared DSP tables for " + juce::String(key) + " Hz");
+    return tables;
+}
+
+template <typename SampleType>
+SharedTables<SampleType>::SharedTables(double sampleRateToUse)
+    : sampleRate(sampleRateToUse)
+{
+    if constexpr (kUsesSaturationTables)
+    {
+        for (int mode = 0; mode < 4; ++mode)
+        {
+            saturationCurves[static_cast<size_t>(mode)].initialise([mode](SampleType x) { return shapeSaturation(mode, x); },
+                                                                   -kSaturationRange, kSaturationRange, kSaturationPoints);
+        }
+    }
+
+    fadeTable.initialise([](float x) { return 0.5f - 0.5f * std::cos(x * juce::MathConstants<float>::pi); },
+                         0.0f, 1.0f, kFadePoints);
+
+    renderCrackleBank();
+}
+
+template <typename SampleType>
+void SharedTables<SampleType>::renderCrackleBank()
+{
+    // Fixed seed: every instance (and every session) gets the same bank
+    std::mt19937 rng(0x0c1a);
+    std::uniform_real_distribution<double> white(-1.0, 1.0);
+
+    const auto onePoleCoeff = [this](double hz) { return std::exp(-juce::MathConstants<double>::twoPi * hz / sampleRate); };
+
+    for (int k = 0; k < kNumCrackleImpulses; ++k)
+    {
+        // Clicks: 0.2-1 ms, bright. Crackles: 1.5-6 ms, darker and noisier.
+        const bool isClick = k < kNumCrackleImpulses / 2;
+        const double position = static_cast<double>(k % (kNumCrackleImpulses / 2)) / (kNumCrackleImpulses / 2 - 1);
+        const double lengthMs = isClick ? 0.2 + position * 0.8 : 1.5 + position * 4.5;
+        const double cutoffHz = juce::jmin(isClick ? 9000.0 : 4500.0, sampleRate * 0.45);
+        const int length = juce::jmax(4, juce::roundToInt(lengthMs * sampleRate / 1000.0));
+
+        const auto lowpass = onePoleCoeff(cutoffHz);
+        const auto highpass = onePoleCoeff(150.0);
+        const double decay = std::exp(-5.0 / length);
+
+        const auto offset = static_cast<int>(crackleBank.size());
+        crackleBank.resize(crackleBank.size() + static_cast<size_t>(length));
+        auto* out = crackleBank.data() + offset;
+
+        // Exponentially decaying noise burst, two-pole lowpass for band-limiting, DC removed
+        double envelope = 1.0, lp1 = 0.0, lp2 = 0.0, hpState = 0.0, peak = 0.0;
+        for (int i = 0; i < length; ++i)
+        {
+            const double excitation = (i == 0 ? 1.0 : white(rng) * (isClick ? 0.4 : 0.9)) * envelope;
+            lp1 = excitation + (lp1 - excitation) * lowpass;
+            lp2 = lp1 + (lp2 - lp1) * lowpass;
+            hpState = lp2 + (hpState - lp2) * highpass;
+
+            const double value = (lp2 - hpState) * std::sin(juce::MathConstants<double>::pi * (i + 1) / (length + 1));
+            out[i] = static_cast<SampleType>(value);
+            peak = juce::jmax(peak, std::abs(value));
+            envelope *= decay;
+        }
+
+        for (int i = 0; i < length; ++i)
+            out[i] = static_cast<SampleType>(out[i] / peak);
+
+        crackleRanges[static_cast<size_t>(k)] = { offset, length };
+    }
+}
+
+template <typename SampleType>
+SampleType SharedTables<SampleType>::shapeSaturation(int mode, SampleType driven) noexcept
+{
+    switch (mode)
+    {
+        case 0: // Cassette: warm tape saturation (even harmonics are added by the caller)
+        {
+            return std::tanh(driven * SampleType(1.5));
+        }
+        case 1: // Vinyl: gentle compression
+        {
+            return driven / (SampleType(1) + std::abs(driven) * SampleType(0.5));
+        }
+        case 2: // VHS: harsh, gritty
+        {
+            // Asymmetric clipping
+            if (driven > SampleType(0.7)) driven = SampleType(0.7) + (driven - SampleType(0.7)) * SampleType(0.2);
+            if (driven < SampleType(-0.5)) driven = SampleType(-0.5) + (driven + SampleType(0.5)) * SampleType(0.3);
+            return std::tanh(driven * SampleType(2));
+        }
+        case 3: // Radio: hard limiting
+        {
+            driven = std::clamp(driven, SampleType(-0.8), SampleType(0.8));
+            return std::tanh(driven * SampleType(2.5));
+        }
+        default:
+            return driven;
+    }
+}
+
+template class SharedTables<float>;
+template class SharedTables<double>;
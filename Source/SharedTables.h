@@ -0,0 +1,94 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+/**
+    Immutable lookup tables shared by every Oxide instance in the process.
+
+    Tables are built lazily on the first prepareToPlay at a given sample rate and
+    handed out as shared_ptr<const SharedTables>; the registry only keeps weak
+    references, so a set is freed when the last instance using it is released.
+    Building and releasing happen off the audio thread; the audio thread only
+    reads through a pointer it was given in prepare.
+*/
+template <typename SampleType>
+class SharedTables
+{
+public:
+    /** Returns the tables for this sample rate, building them if no instance holds them. */
+    static std::shared_ptr<const SharedTables> getFor(double sampleRate);
+
+    double getSampleRate() const noexcept { return sampleRate; }
+
+    /** Mode saturation curve (0=Cassette, 1=Vinyl, 2=VHS, 3=Radio) for an already-driven sample. */
+    SampleType saturate(int mode, SampleType driven) const noexcept
+    {
+        if constexpr (kUsesSaturationTables)
+        {
+            if (std::abs(driven) < kSaturationRange)
+                return saturationCurves[static_cast<size_t>(mode)].processSampleUnchecked(driven);
+        }
+
+        return shapeSaturation(mode, driven);
+    }
+
+    /** Raised-cosine fade, 0 at x = 0 to 1 at x = 1. */
+    float fade(float x) const noexcept
+    {
+        return fadeTable.processSampleUnchecked(x);
+    }
+
+    /** One pre-rendered crackle impulse (peak-normalised, band-limited). */
+    struct Impulse
+    {
+        const SampleType* data = nullptr;
+        int length = 0;
+    };
+
+    static constexpr int kNumCrackleImpulses = 16;
+
+    /** Impulses 0-7 are short clicks, 8-15 longer crackles. */
+    Impulse getCrackleImpulse(int index) const noexcept
+    {
+        const auto& range = crackleRanges[static_cast<size_t>(index)];
+        return { crackleBank.data() + range.first, range.second };
+    }
+
+    /** The exact curve the saturation tables are built from. */
+    static SampleType shapeSaturation(int mode, SampleType driven) noexcept;
+
+    explicit SharedTables(double sampleRateToUse);
+
+private:
+    double sampleRate;
+
+    // Saturation tables (float core only): 8192 linearly interpolated points over
+    // a driven range of +/-32. They're within 1.3e-5 of the exact curve for
+    // Cassette and Vinyl, but 1.2e-4 for Radio and 1.1e-3 for VHS, whose clip
+    // points fall between grid points; the float core accepts that. Outside the
+    // range the exact curve is used (Vinyl is still rising there, towards 2). The
+    // double core is the precise path, so it always evaluates the exact curve.
+    static constexpr bool kUsesSaturationTables = std::is_same_v<SampleType, float>;
+    static constexpr SampleType kSaturationRange = SampleType(32);
+    static constexpr size_t kSaturationPoints = 8192;
+    static constexpr size_t kFadePoints = 256;
+
+    juce::dsp::LookupTableTransform<SampleType> saturationCurves[4];
+    juce::dsp::LookupTableTransform<float> fadeTable;
+
+    // Crackle impulses, rendered at this sample rate so their timbre doesn't change with it
+    void renderCrackleBank();
+    std::vector<SampleType> crackleBank;
+    std::pair<int, int> crackleRanges[kNumCrackleImpulses];   // offset, length
+
+    static std::mutex registryLock;
+    static std::map<int, std::weak_ptr<const SharedTables>> registry;
+
+    JUCE_DECLARE_NON_COPYABLE(SharedTables)
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+
+/**
+    Lock-free triple buffer for handing a value from one writer thread to one
+    reader thread (e.g. message thread -> audio thread).
+
+    The writer fills getWriteBuffer() and calls publish(); the reader calls
+    acquire() and then uses getReadBuffer(). Neither side ever blocks or
+    allocates, and the reader always sees a complete value.
+*/
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    SnapshotBuffer() = default;
+
+    // === Writer side ===
+    T& getWriteBuffer() noexcept { return buffers[writeIndex]; }
+
+    void publish() noexcept
+    {
+        const int previous = shared.exchange(writeIndex | kFreshBit, std::memory_order_acq_rel);
+        writeIndex = previous & kIndexMask;
+    }
+
+    // === Reader side ===
+    /** Picks up the most recently published value. Returns false if nothing new. */
+    bool acquire() noexcept
+    {
+        if ((shared.load(std::memory_order_relaxed) & kFreshBit) == 0)
+            return false;
+
+        const int previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & kIndexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const noexcept { return buffers[readIndex]; }
+
+private:
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kFreshBit = 0x4;
+
+    // Each side's index and the exchanged one on separate cache lines, so the two
+    // threads only ever contend on `shared`
+    T buffers[3] {};
+    alignas(64) int writeIndex = 0;
+    alignas(64) int readIndex = 1;
+    alignas(64) std::atomic<int> shared { 2 };
+
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+};
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "ChannelLanes.h"
+#include <array>
+#include <utility>
+
+/**
+    Jiles-Atherton magnetic hysteresis, the alternative saturation engine for
+    the tape modes (Cassette, VHS).
+
+    The field H is the drive-scaled signal and the output is the magnetisation,
+    normalised so it saturates at +/-1 like the static curves. The model runs at
+    twice the host rate: a linear-phase half-band FIR interpolates the field,
+    the ODE takes one fixed RK2 (midpoint) step per oversampled sample, and the
+    same half-band filters the magnetisation back down, so the harmonics the
+    loop generates above the host's Nyquist are removed instead of folding back.
+    Both filters are polyphase (half their taps are zero), so each costs
+    kHalfTaps multiply-adds per host sample.
+
+    The filter pair delays the output by kLatencySamples. The owner absorbs that
+    inside its own fixed latency by feeding the model from that much earlier in
+    its delay line, so the engine adds no latency of its own.
+
+    Channels are processed a SIMD register at a time, like the rest of the
+    sample loop. The Langevin function is a rational fit rather than
+    coth(q) - 1/q (within 0.0025, and 0.0035 on its slope), so the only
+    operation the registers lack is the reciprocal, done lane by lane.
+
+    State lives in ChannelLanes: the solver's alongside the rest of the
+    per-channel DSP (the owner can pack it with its own via collectLanes), the
+    filter histories in a block of their own that's only touched while the
+    engine runs. Everything is sized in prepare(); process() never allocates.
+*/
+template <typename SampleType>
+class TapeHysteresis
+{
+public:
+    using Vec = typename ChannelLanes<SampleType>::Vec;
+
+    /** Non-zero coefficient pairs either side of each half-band filter's centre tap. */
+    static constexpr int kHalfTaps = 10;
+
+    /** Group delay of the up/down filter pair, in samples at the host rate. */
+    static constexpr int kLatencySamples = 2 * kHalfTaps - 1;
+
+    void prepare(double sampleRate, int numChannels)
+    {
+        stepSize = static_cast<SampleType>(0.5 / sampleRate);   // one step per oversampled sample
+        for (auto* lanes : { &magnetisation, &lastField, &lastFieldRate })
+            lanes->resize(numChannels);
+
+        std::vector<ChannelLanes<SampleType>*> historyLanes;
+        for (auto* history : { &inputHistory, &evenHistory, &oddHistory })
+            for (auto& lanes : *history)
+                historyLanes.push_back(&lanes);
+
+        histories.allocate(std::move(historyLanes), numChannels);
+        historyPos = 0;
+    }
+
+    void release()
+    {
+        for (auto* lanes : { &magnetisation, &lastField, &lastFieldRate })
+            lanes->resize(0);
+
+        histories.release();
+    }
+
+    /** Adds the solver's per-channel state to the owner's list for packing in a ChannelLaneBlock. */
+    void collectLanes(std::vector<ChannelLanes<SampleType>*>& lanes)
+    {
+        lanes.insert(lanes.end(), { &magnetisation, &lastField, &lastFieldRate });
+    }
+
+    void reset()
+    {
+        for (auto* lanes : { &magnetisation, &lastField, &lastFieldRate })
+            lanes->fill(SampleType(0));
+
+        for (auto* history : { &inputHistory, &evenHistory, &oddHistory })
+            for (auto& lanes : *history)
+                lanes.fill(SampleType(0));
+    }
+
+    /** Makes the next process() call restart the solver from its input alone: the
+        field history is set to that sample and the magnetisation to the curve it
+        relaxes to, so state from before (a different warm-up) is forgotten
+        without a jump in the output. The filters only remember kLatencySamples. */
+    void resync() noexcept { resyncPending = true; }
+
+    /** Runs each channel's field through the model; output is kLatencySamples
+        behind field. width (0-1+) sets the coercivity, i.e. how wide the loop opens. */
+    void process(const ChannelLanes<SampleType>& field, ChannelLanes<SampleType>& output,
+                 int numChannels, float width) noexcept
+    {
+        const auto coercivity = Vec::expand(static_cast<SampleType>(0.02f + 0.3f * width));
+        const bool restart = std::exchange(resyncPending, false);
+        const int numGroups = ChannelLanes<SampleType>::getNumGroupsFor(numChannels);
+        const auto at = [this](int delay) { return (historyPos - delay) & (kHistorySize - 1); };
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            inputHistory[static_cast<size_t>(at(0))].group(g) = field.group(g);
+
+            // Up: the odd phase is the input delayed, the even phase interpolates
+            // halfway before it
+            const auto aligned = inputHistory[static_cast<size_t>(at(kHalfTaps - 1))].group(g);
+            const auto halfway = applyHalfBand(inputHistory, g, at) * SampleType(2);
+
+            auto& m = magnetisation.group(g);
+            auto& hPrev = lastField.group(g);
+            auto& hdPrev = lastFieldRate.group(g);
+
+            if (restart)
+            {
+                m = langevin(halfway * (SampleType(1) / kA)).value * kMs;
+                hPrev = halfway;
+                hdPrev = Vec::expand(SampleType(0));
+            }
+
+            evenHistory[static_cast<size_t>(at(0))].group(g) = step(m, hPrev, hdPrev, halfway, coercivity);
+            oddHistory[static_cast<size_t>(at(0))].group(g) = step(m, hPrev, hdPrev, aligned, coercivity);
+
+            // Down: the centre tap lands on an odd-phase output, the rest on even ones
+            output.group(g) = oddHistory[static_cast<size_t>(at(kHalfTaps))].group(g) * SampleType(0.5)
+                            + applyHalfBand(evenHistory, g, at);
+        }
+
+        historyPos = (historyPos + 1) & (kHistorySize - 1);
+    }
+
+private:
+    // Model constants: saturation magnetisation, anhysteretic shape, mean-field
+    // coupling and reversibility. a = 1/3 gives the anhysteretic curve unity slope;
+    // the high reversibility keeps minor loops from collapsing quiet signals.
+    static constexpr SampleType kMs = SampleType(1);
+    static constexpr SampleType kA = SampleType(1.0 / 3.0);
+    static constexpr SampleType kAlpha = SampleType(1.6e-3);
+    static constexpr SampleType kC = SampleType(0.7);
+
+    // Kaiser-windowed (beta 6) half-band, 39 taps: flat within 0.01 dB to 0.4 of
+    // the host rate, -60 dB from 0.6. These are the odd taps outwards from the
+    // centre (whose weight is 0.5); the even ones are zero. Sum 0.25, unity gain.
+    static constexpr std::array<SampleType, kHalfTaps> kHalfBand {
+        SampleType(0.315911996),   SampleType(-0.0990687821), SampleType(0.0525108736),  SampleType(-0.0309861846),
+        SampleType(0.0184874556),  SampleType(-0.0106490703), SampleType(0.00570791243), SampleType(-0.00271789783),
+        SampleType(0.00105287864), SampleType(-0.000249181491)
+    };
+
+    static constexpr int kHistorySize = 32;   // power of two covering the 2 * kHalfTaps the filters read
+    static_assert(kHistorySize >= 2 * kHalfTaps);
+
+    using History = std::array<ChannelLanes<SampleType>, kHistorySize>;
+
+    // The taps either side of the centre, which sits between kHalfTaps - 1 and kHalfTaps back
+    template <typename Index>
+    static Vec applyHalfBand(History& history, int g, const Index& at) noexcept
+    {
+        auto sum = Vec::expand(SampleType(0));
+
+        for (int j = 0; j < kHalfTaps; ++j)
+            sum += (history[static_cast<size_t>(at(kHalfTaps - 1 - j))].group(g)
+                    + history[static_cast<size_t>(at(kHalfTaps + j))].group(g)) * kHalfBand[static_cast<size_t>(j)];
+
+        return sum;
+    }
+
+    Vec step(Vec& m, Vec& hPrev, Vec& hdPrev, Vec h, Vec coercivity) const noexcept
+    {
+        const auto half = SampleType(0.5);
+        const auto hd = (h - hPrev) * (SampleType(1) / stepSize);
+
+        const auto k1 = dMdt(hPrev, hdPrev, m, coercivity) * stepSize;
+        const auto k2 = dMdt((h + hPrev) * half, (hd + hdPrev) * half, m + k1 * half, coercivity) * stepSize;
+
+        m = Vec::min(Vec::max(m + k2, Vec::expand(-kMs)), Vec::expand(kMs));
+        hPrev = h;
+        hdPrev = hd;
+        return m;
+    }
+
+    struct Langevin
+    {
+        Vec value, slope;
+    };
+
+    // L(q) ~= q (4 + 2.25|q| + q^2) / (12 + 6.75|q| + 3.25q^2 + |q|^3): slope 1/3 at
+    // zero and 1 - 1/q for large q like the real thing, with no tanh or branch
+    static Langevin langevin(Vec q) noexcept
+    {
+        const auto x = Vec::max(q, Vec::expand(SampleType(0)) - q);
+        const auto numerator = (x + SampleType(2.25)) * x + SampleType(4);
+        const auto denominator = ((x + SampleType(3.25)) * x + SampleType(6.75)) * x + SampleType(12);
+        const auto numeratorSlope = (x * SampleType(3) + SampleType(4.5)) * x + SampleType(4);
+        const auto denominatorSlope = (x * SampleType(3) + SampleType(6.5)) * x + SampleType(6.75);
+        const auto r = reciprocal(denominator);
+
+        return { q * numerator * r, (numeratorSlope * denominator - x * numerator * denominatorSlope) * r * r };
+    }
+
+    static Vec dMdt(Vec h, Vec hd, Vec m, Vec coercivity) noexcept
+    {
+        const auto zero = Vec::expand(SampleType(0));
+        const auto one = Vec::expand(SampleType(1));
+        const auto anhysteretic = langevin((h + m * kAlpha) * (SampleType(1) / kA));
+
+        // Irreversible part only moves towards the anhysteretic curve; where it's
+        // off, its denominator is swapped for 1 so the shared division stays finite
+        const auto mDiff = anhysteretic.value * kMs - m;
+        const auto rising = Vec::greaterThanOrEqual(hd, zero);
+        const auto direction = (one & rising) + (Vec::expand(SampleType(-1)) & ~rising);
+        const auto pinned = Vec::greaterThan(direction * mDiff, zero);
+        const auto pinning = ((direction * coercivity * (SampleType(1) - kC) - mDiff * kAlpha) & pinned) + (one & ~pinned);
+        const auto irreversible = (mDiff * (SampleType(1) - kC)) & pinned;   // over pinning
+
+        const auto reversible = anhysteretic.slope * (kC * kMs / kA);
+        const auto denominator = one - anhysteretic.slope * (kC * kAlpha * kMs / kA);
+
+        return hd * (irreversible + reversible * pinning) * reciprocal(pinning * denominator);
+    }
+
+    // SIMDRegister has no division: divide lane by lane through an aligned copy,
+    // a loop the optimiser can turn back into one vector divide
+    static Vec reciprocal(Vec x) noexcept
+    {
+        alignas(sizeof(Vec)) SampleType lanes[Vec::size()];
+        x.copyToRawArray(lanes);
+
+        for (auto& lane : lanes)
+            lane = SampleType(1) / lane;
+
+        return Vec::fromRawArray(lanes);
+    }
+
+    SampleType stepSize = SampleType(0.5 / 44100.0);
+    bool resyncPending = false;
+
+    ChannelLanes<SampleType> magnetisation;
+    ChannelLanes<SampleType> lastField;
+    ChannelLanes<SampleType> lastFieldRate;
+
+    // Field in, and the solver's output at the even and odd oversampled phases
+    History inputHistory, evenHistory, oddHistory;
+    ChannelLaneBlock<SampleType> histories;
+    int historyPos = 0;
+};
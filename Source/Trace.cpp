@@ -0,0 +1,177 @@
+#include "Trace.h"
+
+#if OXIDE_ENABLE_TRACING
+
+#include <juce_events/juce_events.h>
+
+std::atomic<TraceSession*> TraceSession::active { nullptr };
+std::atomic<juce::uint32> TraceSession::sessionSerial { 0 };
+std::atomic<int> TraceSession::callsInFlight { 0 };
+
+TraceSession::TraceSession()
+    : juce::Thread("Oxide Trace"),
+      serial(sessionSerial.fetch_add(1) + 1),
+      tracks(std::make_unique<ThreadTrack[]>(kMaxThreads))
+{
+    const auto directoryPath = juce::SystemStats::getEnvironmentVariable("OXIDE_TRACE_DIR", {});
+    const auto directory = juce::File::isAbsolutePath(directoryPath)
+        ? juce::File(directoryPath)
+        : juce::File::getSpecialLocation(juce::File::tempDirectory);
+
+    directory.createDirectory();
+    file = directory.getNonexistentChildFile("Oxide-trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S"),
+                                             ".json", false);
+
+    out = std::make_unique<juce::FileOutputStream>(file);
+    if (out->failedToOpen())
+    {
+        juce::Logger::writeToLog("Oxide trace: can't write " + file.getFullPathName());
+        out.reset();
+        return;
+    }
+
+    originTicks = juce::Time::getHighResolutionTicks();
+    microsecondsPerTick = 1.0e6 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+
+    // JSON array format: still loads if the host dies before the closing bracket
+    *out << "[";
+    writeRecord(R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"Oxide"}})");
+
+    active.store(this, std::memory_order_release);
+    startThread(juce::Thread::Priority::low);
+
+    juce::Logger::writeToLog("Oxide trace: writing " + file.getFullPathName());
+}
+
+TraceSession::~TraceSession()
+{
+    // New calls now see no session; ones that already picked this one up finish
+    // first (a FIFO write at most). Both sides are seq_cst: see CallInFlight.
+    active.store(nullptr);
+    while (callsInFlight.load() > 0)
+        juce::Thread::yield();
+
+    if (out == nullptr)
+        return;
+
+    stopThread(2000);
+
+    *out << "\n]\n";
+    out->flush();
+
+    juce::uint32 dropped = 0;
+    for (int t = 0; t < kMaxThreads; ++t)
+        dropped += tracks[static_cast<size_t>(t)].dropped.load();
+
+    juce::Logger::writeToLog("Oxide trace: wrote " + file.getFullPathName()
+                             + (dropped > 0 ? " (" + juce::String(dropped) + " zones dropped)" : juce::String()));
+}
+
+TraceSession::ThreadTrack* TraceSession::getTrackForThisThread() noexcept
+{
+    // Callers hold a CallInFlight for as long as they use the track
+    auto* session = active.load();
+    if (session == nullptr)
+        return nullptr;
+
+    // A thread claims a track the first time it records in a session
+    thread_local juce::uint32 trackSerial = 0;
+    thread_local int trackIndex = kMaxThreads;
+
+    if (trackSerial != session->serial)
+    {
+        trackSerial = session->serial;
+        trackIndex = session->numTracks.fetch_add(1);
+
+        if (trackIndex < kMaxThreads && juce::MessageManager::existsAndIsCurrentThread())
+            session->tracks[static_cast<size_t>(trackIndex)].name.store("Message thread", std::memory_order_release);
+    }
+
+    // Threads beyond kMaxThreads go unrecorded
+    return trackIndex < kMaxThreads ? &session->tracks[static_cast<size_t>(trackIndex)] : nullptr;
+}
+
+void TraceSession::record(const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept
+{
+    const CallInFlight inFlight;
+    auto* track = getTrackForThisThread();
+    if (track == nullptr)
+        return;
+
+    auto scope = track->fifo.write(1);
+
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+    {
+        track->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    scope.forEach([&](int index) { track->events[static_cast<size_t>(index)] = { name, startTicks, endTicks }; });
+}
+
+void TraceSession::nameThisThread(const char* name) noexcept
+{
+    const CallInFlight inFlight;
+    if (auto* track = getTrackForThisThread())
+        track->name.store(name, std::memory_order_release);
+}
+
+void TraceSession::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(kPollMs);
+    }
+
+    drain();
+}
+
+void TraceSession::drain()
+{
+    const int claimed = numTracks.load(std::memory_order_acquire);
+    const int count = juce::jmin(claimed, kMaxThreads);
+
+    // Logged here rather than by the thread that missed out, which may be the audio thread
+    if (claimed > kMaxThreads && ! loggedThreadLimit)
+    {
+        juce::Logger::writeToLog("Oxide trace: more than " + juce::String(kMaxThreads)
+                                 + " threads recorded zones; the extra threads aren't in the trace");
+        loggedThreadLimit = true;
+    }
+
+    for (int t = 0; t < count; ++t)
+    {
+        auto& track = tracks[static_cast<size_t>(t)];
+        const auto tid = juce::String(t + 1);
+
+        const auto* name = track.name.load(std::memory_order_acquire);
+        if (! track.announced || name != track.announcedName)
+        {
+            const auto label = name != nullptr ? juce::String(name) : "Thread " + tid;
+            writeRecord(R"({"name":"thread_name","ph":"M","pid":1,"tid":)" + tid + R"(,"args":{"name":")" + label + "\"}}");
+            track.announced = true;
+            track.announcedName = name;
+        }
+
+        track.fifo.read(track.fifo.getNumReady()).forEach([&](int index)
+        {
+            const auto& event = track.events[static_cast<size_t>(index)];
+            const auto start = static_cast<double>(event.start - originTicks) * microsecondsPerTick;
+            const auto duration = static_cast<double>(event.end - event.start) * microsecondsPerTick;
+
+            writeRecord(R"({"name":")" + juce::String(event.name) + R"(","cat":"oxide","ph":"X","pid":1,"tid":)" + tid
+                        + R"(,"ts":)" + juce::String(start, 3) + R"(,"dur":)" + juce::String(duration, 3) + "}");
+        });
+    }
+
+    out->flush();
+}
+
+void TraceSession::writeRecord(const juce::String& json)
+{
+    *out << (firstRecord ? "\n" : ",\n") << json;
+    firstRecord = false;
+}
+
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+// Build option (OXIDE_ENABLE_TRACING in CMake): compile in the trace zones below
+#ifndef OXIDE_ENABLE_TRACING
+#define OXIDE_ENABLE_TRACING 0
+#endif
+
+#if OXIDE_ENABLE_TRACING
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+/**
+    Timeline trace of Oxide's hot paths, written as a Chrome trace event JSON
+    file that Perfetto (ui.perfetto.dev) opens directly and Tracy imports with
+    tracy-import-chrome.
+
+    Only compiled in with OXIDE_ENABLE_TRACING; otherwise every macro below is
+    empty. One session is shared by every instance in the process (hold a
+    juce::SharedResourcePointer<TraceSession> for as long as zones may run) and
+    writes one file, to OXIDE_TRACE_DIR or the temp directory.
+
+    Each thread records completed zones into its own fixed FIFO: no locks and,
+    after the thread's first zone, no allocation, so zones are safe on the audio
+    thread. A low-priority writer drains the FIFOs to disk. A thread that
+    outruns the writer drops zones rather than waiting; the count is logged
+    when the session ends. Threads beyond kMaxThreads aren't recorded (logged
+    once, by the writer).
+*/
+class TraceSession : private juce::Thread
+{
+public:
+    TraceSession();
+    ~TraceSession() override;
+
+    // === Any thread ===
+    /** Records a completed zone; names must be string literals (only the pointer is kept). */
+    static void record(const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    /** Names the calling thread's track in the trace (string literal). */
+    static void nameThisThread(const char* name) noexcept;
+
+private:
+    static constexpr int kMaxThreads = 16;
+    static constexpr int kEventsPerThread = 8192;
+    static constexpr int kPollMs = 50;
+
+    struct Event
+    {
+        const char* name = nullptr;
+        juce::int64 start = 0;
+        juce::int64 end = 0;
+    };
+
+    struct ThreadTrack
+    {
+        juce::AbstractFifo fifo { kEventsPerThread };
+        std::array<Event, kEventsPerThread> events {};
+        std::atomic<const char*> name { nullptr };
+        std::atomic<juce::uint32> dropped { 0 };
+        bool announced = false;                     // writer only: track named in the file
+        const char* announcedName = nullptr;        // ... as this
+    };
+
+    static ThreadTrack* getTrackForThisThread() noexcept;
+
+    // Calls that may be touching the active session's tracks: ending a session
+    // clears `active`, then waits for this to reach zero before freeing them
+    static std::atomic<int> callsInFlight;
+
+    struct CallInFlight
+    {
+        CallInFlight() noexcept { callsInFlight.fetch_add(1); }
+        ~CallInFlight() { callsInFlight.fetch_sub(1); }
+    };
+
+    void run() override;
+    void drain();
+
+    static std::atomic<TraceSession*> active;
+    static std::atomic<juce::uint32> sessionSerial;
+
+    juce::uint32 serial = 0;
+    std::unique_ptr<ThreadTrack[]> tracks;
+    std::atomic<int> numTracks { 0 };
+
+    // Writer only
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> out;
+    juce::int64 originTicks = 0;
+    double microsecondsPerTick = 1.0;
+    bool firstRecord = true;
+    bool loggedThreadLimit = false;
+
+    void writeRecord(const juce::String& json);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceSession)
+};
+
+/** Times its own scope (or up to end()) and records it to the active session, if any. */
+class TraceZone
+{
+public:
+    explicit TraceZone(const char* zoneName) noexcept
+        : name(zoneName), start(juce::Time::getHighResolutionTicks())
+    {
+    }
+
+    ~TraceZone() { end(); }
+
+    void end() noexcept
+    {
+        if (name != nullptr)
+            TraceSession::record(name, start, juce::Time::getHighResolutionTicks());
+        name = nullptr;
+    }
+
+private:
+    const char* name;
+    juce::int64 start;
+
+    JUCE_DECLARE_NON_COPYABLE(TraceZone)
+};
+
+#define OXIDE_TRACE_ZONE(name)              TraceZone JUCE_JOIN_MACRO(oxideTraceZone, __LINE__) (name)
+#define OXIDE_TRACE_ZONE_BEGIN(zone, name)  TraceZone zone (name)
+#define OXIDE_TRACE_ZONE_END(zone)          zone.end()
+#define OXIDE_TRACE_THREAD(name)            TraceSession::nameThisThread(name)
+
+#else
+
+#define OXIDE_TRACE_ZONE(name)
+#define OXIDE_TRACE_ZONE_BEGIN(zone, name)
+#define OXIDE_TRACE_ZONE_END(zone)
+#define OXIDE_TRACE_THREAD(name)
+
+#endif
@@ -0,0 +1,100 @@
+#include "WaveformHistory.h"
+
+void WaveformHistory::prepare(double sampleRate, int maxBlockSize)
+{
+    samplesPerColumn = juce::jmax(1, juce::roundToInt(sampleRate / kColumnRate));
+    staged.assign(static_cast<size_t>(juce::jmax(1, maxBlockSize) / samplesPerColumn + 2), Column {});
+    pendingSamples = 0;
+    capturingBlock = false;
+}
+
+void WaveformHistory::setEnabled(bool shouldCapture) noexcept
+{
+    if (shouldCapture && ! enabled.load(std::memory_order_relaxed))
+        fifo.read(fifo.getNumReady());
+
+    enabled.store(shouldCapture, std::memory_order_release);
+}
+
+int WaveformHistory::read(Column* destination, int maxColumns) noexcept
+{
+    int numRead = 0;
+    fifo.read(maxColumns).forEach([&](int index) { destination[numRead++] = columns[static_cast<size_t>(index)]; });
+    return numRead;
+}
+
+template <typename SampleType>
+int WaveformHistory::accumulate(const juce::AudioBuffer<SampleType>& buffer, bool post) noexcept
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numStaged = static_cast<int>(staged.size());
+
+    int column = 0;
+    int filled = pendingSamples;
+
+    for (int start = 0; start < numSamples && column < numStaged;)
+    {
+        const int length = juce::jmin(numSamples - start, samplesPerColumn - filled);
+        auto& target = staged[static_cast<size_t>(column)];
+        float& low = post ? target.postMin : target.preMin;
+        float& high = post ? target.postMax : target.preMax;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            const auto range = buffer.findMinMax(ch, start, length);
+            const bool fresh = filled == 0 && ch == 0;
+            low = fresh ? static_cast<float>(range.getStart()) : juce::jmin(low, static_cast<float>(range.getStart()));
+            high = fresh ? static_cast<float>(range.getEnd()) : juce::jmax(high, static_cast<float>(range.getEnd()));
+        }
+
+        start += length;
+        filled += length;
+
+        if (filled == samplesPerColumn)
+        {
+            ++column;
+            filled = 0;
+        }
+    }
+
+    return column;
+}
+
+template <typename SampleType>
+void WaveformHistory::capturePre(const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    const bool wasCapturing = capturingBlock;
+    capturingBlock = enabled.load(std::memory_order_acquire) && buffer.getNumChannels() > 0 && ! staged.empty();
+
+    if (! capturingBlock)
+        return;
+
+    // Picking up again after a pause: start a fresh column
+    if (! wasCapturing)
+        pendingSamples = 0;
+
+    accumulate(buffer, false);
+}
+
+template <typename SampleType>
+void WaveformHistory::capturePost(const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    if (! capturingBlock)
+        return;
+
+    const int completed = accumulate(buffer, true);
+
+    // A full FIFO (reader stalled) drops the newest columns
+    int next = 0;
+    fifo.write(completed).forEach([&](int index) { columns[static_cast<size_t>(index)] = staged[static_cast<size_t>(next++)]; });
+
+    // Carry the unfinished column into the next block
+    pendingSamples = (pendingSamples + buffer.getNumSamples()) % samplesPerColumn;
+    if (pendingSamples > 0 && completed < static_cast<int>(staged.size()))
+        staged.front() = staged[static_cast<size_t>(completed)];
+}
+
+template void WaveformHistory::capturePre<float>(const juce::AudioBuffer<float>&) noexcept;
+template void WaveformHistory::capturePre<double>(const juce::AudioBuffer<double>&) noexcept;
+template void WaveformHistory::capturePost<float>(const juce::AudioBuffer<float>&) noexcept;
+template void WaveformHistory::capturePost<double>(const juce::AudioBuffer<double>&) noexcept;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+    Min/max-decimated waveform of the input and output, for the visualizer.
+
+    The audio thread reduces each block to fixed-rate columns (the extremes of
+    every channel over 1/kColumnRate s, before and after the effect) and pushes
+    finished columns into a lock-free FIFO; the editor drains them a frame at a
+    time. Only a few floats per column ever leave the audio thread.
+
+    Capture is off until a reader enables it, so nothing is computed while no
+    editor is showing the visualizer.
+*/
+class WaveformHistory
+{
+public:
+    static constexpr int kColumnRate = 100;         // columns per second
+    static constexpr int kFifoColumns = 512;        // a few seconds of backlog for a stalled reader
+
+    struct Column
+    {
+        float preMin = 0.0f;
+        float preMax = 0.0f;
+        float postMin = 0.0f;
+        float postMax = 0.0f;
+    };
+
+    void prepare(double sampleRate, int maxBlockSize);
+
+    // === Audio thread ===
+    /** Call on the input before processing and on the output after, once each per block. */
+    template <typename SampleType>
+    void capturePre(const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    template <typename SampleType>
+    void capturePost(const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    // === Reader (message thread) ===
+    /** Starting drops whatever was left over from the last time capture ran. */
+    void setEnabled(bool shouldCapture) noexcept;
+
+    /** Copies out up to maxColumns of the oldest unread columns; returns how many. */
+    int read(Column* destination, int maxColumns) noexcept;
+
+private:
+    // Folds the block into the staged columns, starting part way through the pending one
+    template <typename SampleType>
+    int accumulate(const juce::AudioBuffer<SampleType>& buffer, bool post) noexcept;
+
+    std::atomic<bool> enabled { false };
+
+    // Audio thread only
+    int samplesPerColumn = 441;
+    int pendingSamples = 0;                 // samples already in the first staged column
+    bool capturingBlock = false;            // capturePre ran for this block
+    std::vector<Column> staged;             // columns this block touches (first one carried over)
+
+    juce::AbstractFifo fifo { kFifoColumns };
+    std::array<Column, kFifoColumns> columns {};
+};
@@ -5,8 +5,16 @@ import { ModeSelector } from './components/ModeSelector';
 import { OxideVisualizer } from './components/OxideVisualizer';
 import { PresetSelector } from './components/PresetSelector';
 import { ActivationScreen } from './components/ActivationScreen';
+import { FrameRateSelector } from './components/FrameRateSelector';
+import { MorphControl } from './components/MorphControl';
+import { OptionSelector } from './components/OptionSelector';
+import { CpuMeter } from './components/CpuMeter';
+import { EditorSwitch } from './components/EditorSwitch';
+import { LoudnessReadout } from './components/LoudnessReadout';
 import { useSliderParam, useToggleParam, useChoiceParam } from './hooks/useJuceParam';
-import { useVisualizerData } from './hooks/useVisualizerData';
+import { useVisualizerData, useVisualizerFrameRate } from './hooks/useVisualizerData';
+import { useTelemetryData } from './hooks/useTelemetryData';
+import { useLoudnessData } from './hooks/useLoudnessData';
 
 function PluginUI() {
   // Parameters
@@ -25,8 +33,22 @@ function PluginUI() {
   const mix = useSliderParam('mix', 100);
   const output = useSliderParam('output', 0);
   const bypass = useToggleParam('bypass', false);
+  const morph = useSliderParam('morph', 0);
+  const morphOn = useToggleParam('morphOn', false);
+  const crushMode = useChoiceParam('crushMode', 2, 0);
+  const satEngine = useChoiceParam('satEngine', 2, 0);
+  const envAttack = useSliderParam('envAttack', 10);
+  const envRelease = useSliderParam('envRelease', 200);
+  const envMode = useChoiceParam('envMode', 2, 1);
+  const envToAge = useSliderParam('envToAge', 0);
+  const envToNoise = useSliderParam('envToNoise', 0);
+  const envToSaturation = useSliderParam('envToSaturation', 0);
+  const envToFilter = useSliderParam('envToFilter', 0);
 
   const visualizerData = useVisualizerData();
+  const [frameRate, setFrameRate] = useVisualizerFrameRate();
+  const [telemetry, resetTelemetry] = useTelemetryData();
+  const [loudness, loudnessControls] = useLoudnessData();
 
   // Mode colors
   const modeColors = ['#ff6b35', '#8b5cf6', '#06b6d4', '#22c55e'];
@@ -52,7 +74,12 @@ function PluginUI() {
         >
           OXIDE
         </h1>
-        <div className="header-spacer" />
+        <div className="header-spacer">
+          <LoudnessReadout data={loudness} controls={loudnessControls} />
+          <CpuMeter data={telemetry} onReset={resetTelemetry} />
+          <FrameRateSelector value={frameRate} onChange={setFrameRate} />
+          <EditorSwitch />
+        </div>
       </header>
 
       {/* Main content */}
@@ -94,6 +121,13 @@ function PluginUI() {
               onDragEnd={crackle.dragEnd}
             />
           </div>
+          <OptionSelector
+            label="CRUSH"
+            options={['Raw', 'Clean']}
+            value={crushMode.value}
+            onChange={crushMode.setChoice}
+            title="Raw: hard hold and rounding. Clean: band-limited and dithered"
+          />
         </section>
 
         {/* Center - Visualizer */}
@@ -101,6 +135,7 @@ function PluginUI() {
           <OxideVisualizer
             mode={mode.value}
             degradation={visualizerData.degradation}
+            frameRate={frameRate}
           />
           <ModeSelector
             value={mode.value}
@@ -146,6 +181,13 @@ function PluginUI() {
               onDragEnd={age.dragEnd}
             />
           </div>
+          <OptionSelector
+            label="TAPE SAT"
+            options={['Curve', 'Hysteresis']}
+            value={satEngine.value}
+            onChange={satEngine.setChoice}
+            title="Saturation engine for Cassette and VHS"
+          />
         </section>
       </main>
 
@@ -183,6 +225,107 @@ function PluginUI() {
 
         <div className="footer-divider" />
 
+        <div className="footer-section morph-section">
+          <h3 className="footer-title">Morph</h3>
+          <MorphControl
+            value={morph.value}
+            enabled={morphOn.value}
+            color={currentColor}
+            onChange={morph.setValue}
+            onDragStart={morph.dragStart}
+            onDragEnd={morph.dragEnd}
+            onToggle={morphOn.toggle}
+          />
+        </div>
+
+        <div className="footer-divider" />
+
+        <div className="footer-section envelope-section">
+          <h3 className="footer-title">Envelope</h3>
+          <div className="envelope-knobs">
+            <Knob
+              value={envAttack.value}
+              min={0.5}
+              max={200}
+              unit="ms"
+              label="ATTACK"
+              color={currentColor}
+              size="sm"
+              onChange={envAttack.setValue}
+              onDragStart={envAttack.dragStart}
+              onDragEnd={envAttack.dragEnd}
+            />
+            <Knob
+              value={envRelease.value}
+              min={10}
+              max={2000}
+              unit="ms"
+              label="RELEASE"
+              color={currentColor}
+              size="sm"
+              onChange={envRelease.setValue}
+              onDragStart={envRelease.dragStart}
+              onDragEnd={envRelease.dragEnd}
+            />
+            <Knob
+              value={envToAge.value}
+              min={-100}
+              max={100}
+              bipolar
+              label="> AGE"
+              color={currentColor}
+              size="sm"
+              onChange={envToAge.setValue}
+              onDragStart={envToAge.dragStart}
+              onDragEnd={envToAge.dragEnd}
+            />
+            <Knob
+              value={envToNoise.value}
+              min={-100}
+              max={100}
+              bipolar
+              label="> NOISE"
+              color={currentColor}
+              size="sm"
+              onChange={envToNoise.setValue}
+              onDragStart={envToNoise.dragStart}
+              onDragEnd={envToNoise.dragEnd}
+            />
+            <Knob
+              value={envToSaturation.value}
+              min={-100}
+              max={100}
+              bipolar
+              label="> SAT"
+              color={currentColor}
+              size="sm"
+              onChange={envToSaturation.setValue}
+              onDragStart={envToSaturation.dragStart}
+              onDragEnd={envToSaturation.dragEnd}
+            />
+            <Knob
+              value={envToFilter.value}
+              min={-100}
+              max={100}
+              bipolar
+              label="> CUTOFF"
+              color={currentColor}
+              size="sm"
+              onChange={envToFilter.setValue}
+              onDragStart={envToFilter.dragStart}
+              onDragEnd={envToFilter.dragEnd}
+            />
+          </div>
+          <OptionSelector
+            label="DETECT"
+            options={['Peak', 'RMS']}
+            value={envMode.value}
+            onChange={envMode.setChoice}
+          />
+        </div>
+
+        <div className="footer-divider" />
+
         <div className="footer-section output-section">
           <h3 className="footer-title">Output</h3>
           <div className="output-knobs">
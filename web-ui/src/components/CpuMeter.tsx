@@ -0,0 +1,73 @@
+import { TelemetryData } from '../hooks/useTelemetryData';
+
+interface CpuMeterProps {
+  data: TelemetryData;
+  onReset: () => void;
+}
+
+const percent = (load: number) => `${Math.round(load * 100)}%`;
+
+/** Compact deadline readout: mean load, with near-misses and overruns; click to reset */
+export function CpuMeter({ data, onReset }: CpuMeterProps) {
+  const state = data.overruns > 0 ? 'overrun' : data.nearMisses > 0 ? 'near-miss' : '';
+
+  // Most expensive configuration seen so far, for the tooltip
+  const heaviest = data.configurations.reduce<TelemetryData['configurations'][number] | null>(
+    (worst, c) => (worst === null || c.meanLoad > worst.meanLoad ? c : worst), null);
+
+  const title = [
+    `Block load: mean ${percent(data.meanLoad)}, peak ${percent(data.peakLoad)} of the buffer period`,
+    `Near-misses: ${data.nearMisses}, overruns: ${data.overruns} in ${data.blocks} blocks`,
+    heaviest ? `Heaviest: ${heaviest.mode} / ${heaviest.crushMode} / ${heaviest.satEngine} (${percent(heaviest.meanLoad)})` : '',
+    'Click to reset'
+  ].filter(Boolean).join('\n');
+
+  return (
+    <button className={`cpu-meter ${state}`} title={title} onClick={onReset}>
+      <span className="cpu-meter-label">DSP</span>
+      {percent(data.meanLoad)}
+      {data.overruns > 0 && <span className="cpu-meter-count">{data.overruns}</span>}
+
+      <style>{`
+        .cpu-meter {
+          display: flex;
+          align-items: center;
+          gap: 4px;
+          padding: 3px 6px;
+          background: transparent;
+          border: 1px solid transparent;
+          border-radius: 4px;
+          font-size: 9px;
+          font-weight: 600;
+          font-variant-numeric: tabular-nums;
+          color: rgba(255,255,255,0.3);
+          cursor: pointer;
+          transition: all 0.15s;
+        }
+
+        .cpu-meter:hover {
+          color: rgba(255,255,255,0.6);
+        }
+
+        .cpu-meter.near-miss {
+          color: #eab308;
+        }
+
+        .cpu-meter.overrun {
+          color: #ef4444;
+          border-color: rgba(239,68,68,0.3);
+        }
+
+        .cpu-meter-label {
+          letter-spacing: 1px;
+        }
+
+        .cpu-meter-count {
+          padding: 0 3px;
+          border-radius: 3px;
+          background: rgba(239,68,68,0.2);
+        }
+      `}</style>
+    </button>
+  );
+}
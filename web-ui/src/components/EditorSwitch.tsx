@@ -0,0 +1,50 @@
+import { useState } from 'react';
+import { isInJuceWebView, emitEvent } from '../lib/juce-bridge';
+
+/** Switches this instance to the native editor; hosts only swap editors when it is reopened */
+export function EditorSwitch() {
+  const [pending, setPending] = useState(false);
+
+  if (!isInJuceWebView()) return null;
+
+  const toggle = () => {
+    emitEvent('setNativeEditor', { enabled: !pending });
+    setPending(!pending);
+  };
+
+  return (
+    <button
+      className={`editor-switch ${pending ? 'pending' : ''}`}
+      title={pending
+        ? 'The native editor opens next time. Click to keep the web UI'
+        : 'Use the lightweight native editor (takes effect when the editor is reopened)'}
+      onClick={toggle}
+    >
+      {pending ? 'REOPEN' : 'LITE'}
+
+      <style>{`
+        .editor-switch {
+          padding: 3px 6px;
+          background: transparent;
+          border: 1px solid transparent;
+          border-radius: 4px;
+          font-size: 9px;
+          font-weight: 600;
+          letter-spacing: 1px;
+          color: rgba(255,255,255,0.3);
+          cursor: pointer;
+          transition: all 0.15s;
+        }
+
+        .editor-switch:hover {
+          color: rgba(255,255,255,0.6);
+        }
+
+        .editor-switch.pending {
+          color: var(--accent-color, #ff6b35);
+          border-color: var(--accent-color, #ff6b35);
+        }
+      `}</style>
+    </button>
+  );
+}
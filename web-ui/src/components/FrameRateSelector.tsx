@@ -0,0 +1,61 @@
+import { visualizerFrameRates, VisualizerFrameRate } from '../hooks/useVisualizerData';
+
+interface FrameRateSelectorProps {
+  value: VisualizerFrameRate;
+  onChange: (rate: VisualizerFrameRate) => void;
+}
+
+export function FrameRateSelector({ value, onChange }: FrameRateSelectorProps) {
+  return (
+    <div className="frame-rate-selector" title="Visualizer frame rate">
+      {visualizerFrameRates.map((rate) => (
+        <button
+          key={rate}
+          className={`frame-rate-btn ${value === rate ? 'active' : ''}`}
+          onClick={() => onChange(rate)}
+        >
+          {rate}
+        </button>
+      ))}
+      <span className="frame-rate-unit">FPS</span>
+
+      <style>{`
+        .frame-rate-selector {
+          display: flex;
+          align-items: center;
+          justify-content: flex-end;
+          gap: 2px;
+        }
+
+        .frame-rate-btn {
+          padding: 3px 6px;
+          background: transparent;
+          border: 1px solid transparent;
+          border-radius: 4px;
+          font-size: 9px;
+          font-weight: 600;
+          color: rgba(255,255,255,0.3);
+          cursor: pointer;
+          transition: all 0.15s;
+        }
+
+        .frame-rate-btn:hover {
+          color: rgba(255,255,255,0.6);
+        }
+
+        .frame-rate-btn.active {
+          color: var(--accent-color, #ff6b35);
+          border-color: rgba(255,255,255,0.08);
+          background: rgba(0,0,0,0.3);
+        }
+
+        .frame-rate-unit {
+          margin-left: 4px;
+          font-size: 9px;
+          letter-spacing: 1px;
+          color: rgba(255,255,255,0.3);
+        }
+      `}</style>
+    </div>
+  );
+}
@@ -0,0 +1,94 @@
+import { LoudnessData, LoudnessControls, LoudnessReading } from '../hooks/useLoudnessData';
+
+interface LoudnessReadoutProps {
+  data: LoudnessData;
+  controls: LoudnessControls;
+}
+
+const isSilent = (value: number) => value <= -70;
+const format = (value: number) => (isSilent(value) ? '--' : value.toFixed(1));
+
+const describe = (label: string, r: LoudnessReading) =>
+  `${label}: M ${format(r.momentary)}  S ${format(r.shortTerm)}  I ${format(r.integrated)} LUFS  TP ${format(r.truePeak)} dBTP`;
+
+/** Output short-term loudness and its difference from the input; MATCH levels them */
+export function LoudnessReadout({ data, controls }: LoudnessReadoutProps) {
+  const { input, output } = data;
+  const measurable = !isSilent(input.shortTerm) && !isSilent(output.shortTerm);
+  const delta = output.shortTerm - input.shortTerm;
+  const clipping = output.truePeak > 0;
+
+  const title = [
+    describe('Input', input),
+    describe('Output', output),
+    'Click the reading to reset integrated loudness and true peak'
+  ].join('\n');
+
+  return (
+    <div className="loudness-readout">
+      <button className={`loudness-value ${clipping ? 'clipping' : ''}`} title={title} onClick={controls.reset}>
+        <span className="loudness-label">LUFS</span>
+        {format(output.shortTerm)}
+        {measurable && (
+          <span className="loudness-delta">{delta >= 0 ? '+' : ''}{delta.toFixed(1)}</span>
+        )}
+      </button>
+      <button
+        className="loudness-match"
+        title="Set the output gain so the output is as loud as the input"
+        disabled={!measurable}
+        onClick={controls.match}
+      >
+        MATCH
+      </button>
+
+      <style>{`
+        .loudness-readout {
+          display: flex;
+          align-items: center;
+          gap: 2px;
+        }
+
+        .loudness-value,
+        .loudness-match {
+          display: flex;
+          align-items: center;
+          gap: 4px;
+          padding: 3px 6px;
+          background: transparent;
+          border: 1px solid transparent;
+          border-radius: 4px;
+          font-size: 9px;
+          font-weight: 600;
+          font-variant-numeric: tabular-nums;
+          color: rgba(255,255,255,0.3);
+          cursor: pointer;
+          transition: all 0.15s;
+        }
+
+        .loudness-value:hover,
+        .loudness-match:hover:not(:disabled) {
+          color: rgba(255,255,255,0.6);
+        }
+
+        .loudness-value.clipping {
+          color: #ef4444;
+        }
+
+        .loudness-label,
+        .loudness-match {
+          letter-spacing: 1px;
+        }
+
+        .loudness-delta {
+          color: var(--accent-color, #ff6b35);
+        }
+
+        .loudness-match:disabled {
+          opacity: 0.4;
+          cursor: default;
+        }
+      `}</style>
+    </div>
+  );
+}
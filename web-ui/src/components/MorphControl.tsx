@@ -0,0 +1,80 @@
+import { Knob } from './Knob';
+import { emitEvent } from '../lib/juce-bridge';
+
+interface MorphControlProps {
+  value: number;
+  enabled: boolean;
+  color: string;
+  onChange: (value: number) => void;
+  onDragStart: () => void;
+  onDragEnd: () => void;
+  onToggle: () => void;
+}
+
+/**
+ * A/B morph: store the current sound into A or B, then sweep between them.
+ * The snapshots live in the processor; the knob is an ordinary parameter.
+ */
+export function MorphControl({ value, enabled, color, onChange, onDragStart, onDragEnd, onToggle }: MorphControlProps) {
+  const store = (slot: 0 | 1) => emitEvent('storeMorphSnapshot', { slot });
+
+  return (
+    <div className={`morph-control ${enabled ? 'enabled' : ''}`}>
+      <div className="morph-slots">
+        <button className="morph-slot" onClick={() => store(0)} title="Store current sound as A">A</button>
+        <button className="morph-slot" onClick={() => store(1)} title="Store current sound as B">B</button>
+      </div>
+      <Knob
+        value={value}
+        label="MORPH"
+        color={color}
+        onChange={onChange}
+        onDragStart={onDragStart}
+        onDragEnd={onDragEnd}
+      />
+      <button className="morph-toggle" onClick={onToggle}>
+        {enabled ? 'ON' : 'OFF'}
+      </button>
+
+      <style>{`
+        .morph-control {
+          display: flex;
+          align-items: center;
+          gap: 10px;
+        }
+
+        .morph-slots {
+          display: flex;
+          flex-direction: column;
+          gap: 4px;
+        }
+
+        .morph-slot,
+        .morph-toggle {
+          padding: 4px 8px;
+          background: rgba(0,0,0,0.3);
+          border: 1px solid rgba(255,255,255,0.08);
+          border-radius: 4px;
+          font-size: 9px;
+          font-weight: 600;
+          letter-spacing: 1px;
+          color: rgba(255,255,255,0.5);
+          cursor: pointer;
+          transition: all 0.15s;
+        }
+
+        .morph-slot:hover,
+        .morph-toggle:hover {
+          border-color: rgba(255,255,255,0.15);
+          color: rgba(255,255,255,0.8);
+        }
+
+        .morph-control.enabled .morph-toggle {
+          background: rgba(255,107,53,0.15);
+          border-color: rgba(255,107,53,0.3);
+          color: #ff6b35;
+        }
+      `}</style>
+    </div>
+  );
+}
@@ -0,0 +1,65 @@
+interface OptionSelectorProps {
+  label: string;
+  options: readonly string[];
+  value: number;
+  onChange: (index: number) => void;
+  title?: string;
+}
+
+/** Small segmented switch for a choice parameter (e.g. crush mode, saturation engine) */
+export function OptionSelector({ label, options, value, onChange, title }: OptionSelectorProps) {
+  return (
+    <div className="option-selector" title={title}>
+      <span className="option-selector-label">{label}</span>
+      {options.map((name, index) => (
+        <button
+          key={name}
+          className={`option-selector-btn ${value === index ? 'active' : ''}`}
+          onClick={() => onChange(index)}
+        >
+          {name}
+        </button>
+      ))}
+
+      <style>{`
+        .option-selector {
+          display: flex;
+          align-items: center;
+          justify-content: center;
+          gap: 2px;
+          margin-top: 8px;
+        }
+
+        .option-selector-label {
+          margin-right: 4px;
+          font-size: 9px;
+          letter-spacing: 1px;
+          color: rgba(255,255,255,0.3);
+        }
+
+        .option-selector-btn {
+          padding: 3px 8px;
+          background: transparent;
+          border: 1px solid transparent;
+          border-radius: 4px;
+          font-size: 9px;
+          font-weight: 600;
+          text-transform: uppercase;
+          color: rgba(255,255,255,0.3);
+          cursor: pointer;
+          transition: all 0.15s;
+        }
+
+        .option-selector-btn:hover {
+          color: rgba(255,255,255,0.6);
+        }
+
+        .option-selector-btn.active {
+          color: var(--accent-color, #ff6b35);
+          border-color: rgba(255,255,255,0.08);
+          background: rgba(0,0,0,0.3);
+        }
+      `}</style>
+    </div>
+  );
+}
@@ -1,11 +1,17 @@
 import { useRef, useEffect } from 'react';
-import { useVisualizerData } from '../hooks/useVisualizerData';
+import { useVisualizerData, setVisualizerActive } from '../hooks/useVisualizerData';
+import { useWaveformData } from '../hooks/useWaveformData';
 
 interface OxideVisualizerProps {
   mode: number;
   degradation: number;
+  /** Frame budget in Hz (15/30/60) */
+  frameRate: number;
 }
 
+// One waveform column per lo-fi pixel across the 280px canvas
+const waveformColumns = 70;
+
 // Mode color palettes for the pixel scene
 const modePalettes = [
   // Cassette - warm sunset city
@@ -18,12 +24,30 @@ const modePalettes = [
   { sky: ['#0a1a0a', '#0a2a1a', '#0a3a2a', '#1a5a3a', '#22c55e'], buildings: '#080a08', windows: '#4ade80', accent: '#22c55e' }
 ];
 
-export function OxideVisualizer({ mode, degradation }: OxideVisualizerProps) {
+export function OxideVisualizer({ mode, degradation, frameRate }: OxideVisualizerProps) {
   const canvasRef = useRef<HTMLCanvasElement>(null);
   const visualizerData = useVisualizerData();
+  const waveformRef = useWaveformData(waveformColumns);
   const animationRef = useRef<number>();
   const timeRef = useRef(0);
 
+  // Latest data is read from a ref so new events don't rebuild the scene
+  const dataRef = useRef(visualizerData);
+  dataRef.current = visualizerData;
+
+  // Only ask C++ for data while we're mounted and the page is visible
+  useEffect(() => {
+    const onVisibilityChange = () => setVisualizerActive(!document.hidden);
+
+    setVisualizerActive(!document.hidden);
+    document.addEventListener('visibilitychange', onVisibilityChange);
+
+    return () => {
+      document.removeEventListener('visibilitychange', onVisibilityChange);
+      setVisualizerActive(false);
+    };
+  }, []);
+
   useEffect(() => {
     const canvas = canvasRef.current;
     if (!canvas) return;
@@ -75,14 +99,25 @@ export function OxideVisualizer({ mode, degradation }: OxideVisualizerProps) {
       });
     }
 
-    const animate = () => {
-      timeRef.current += 0.016;
+    // Scratch buffer for the CRT pixel pass, allocated once per scene
+    const pixelScratch = new Uint8ClampedArray(width * height * 4);
+
+    const frameInterval = 1000 / frameRate;
+    let lastFrameTime = 0;
+
+    const animate = (now: number = performance.now()) => {
+      animationRef.current = requestAnimationFrame(animate);
+
+      // Stay within the frame budget; the browser itself stops rAF when hidden
+      if (now - lastFrameTime < frameInterval - 1) return;
+      const elapsed = lastFrameTime > 0 ? Math.min(now - lastFrameTime, 100) : frameInterval;
+      lastFrameTime = now;
+
+      timeRef.current += elapsed / 1000;
       const t = timeRef.current;
 
-      const rms = visualizerData.rms;
-      const peak = visualizerData.peak;
-      const wobblePhase = visualizerData.wobblePhase;
-      const crackle = visualizerData.crackleActivity;
+      const { rms, peak, wobblePhase } = dataRef.current;
+      const crackle = dataRef.current.crackleActivity;
       const deg = degradation / 100;
 
       // Clear offscreen with sky gradient
@@ -119,6 +154,25 @@ export function OxideVisualizer({ mode, degradation }: OxideVisualizerProps) {
       offCtx.arc(moonX, moonY, 2, 0, Math.PI * 2);
       offCtx.fill();
 
+      // Real signal behind the skyline, oldest column on the left: input faint, output in the accent
+      const wave = waveformRef.current;
+      const scopeY = pxHeight * 0.45;
+      const scopeHeight = pxHeight * 0.2;
+      const columnAt = (x: number) => ((wave.head + x) % wave.columns) * 2;
+      const clamp = (v: number) => Math.max(-1, Math.min(1, v));
+
+      const drawScope = (columns: Float32Array, color: string) => {
+        offCtx.fillStyle = color;
+        for (let x = 0; x < Math.min(pxWidth, wave.columns); x++) {
+          const slot = columnAt(x);
+          const top = Math.round(scopeY - clamp(columns[slot + 1]) * scopeHeight);
+          const bottom = Math.round(scopeY - clamp(columns[slot]) * scopeHeight);
+          offCtx.fillRect(x, top, 1, Math.max(1, bottom - top + 1));
+        }
+      };
+      drawScope(wave.pre, 'rgba(255, 255, 255, 0.12)');
+      drawScope(wave.post, palette.accent + '70');
+
       // Draw buildings
       const groundY = pxHeight - 5;
       buildings.forEach(building => {
@@ -150,11 +204,11 @@ export function OxideVisualizer({ mode, degradation }: OxideVisualizerProps) {
       offCtx.fillStyle = palette.accent + '40';
       offCtx.fillRect(0, groundY, pxWidth, 1);
 
-      // Audio waveform at bottom (like a reflection)
+      // Output envelope at the bottom (like a reflection)
       offCtx.fillStyle = palette.accent + '20';
-      for (let x = 0; x < pxWidth; x++) {
-        const wave = Math.sin(x * 0.2 + t * 5) * rms * 3;
-        const h = Math.abs(wave);
+      for (let x = 0; x < Math.min(pxWidth, wave.columns); x++) {
+        const slot = columnAt(x);
+        const h = Math.max(Math.abs(wave.post[slot]), Math.abs(wave.post[slot + 1])) * 3;
         offCtx.fillRect(x, groundY + 2, 1, Math.min(3, h));
       }
 
@@ -164,51 +218,36 @@ export function OxideVisualizer({ mode, degradation }: OxideVisualizerProps) {
       ctx.imageSmoothingEnabled = false;
       ctx.drawImage(offscreen, 0, 0, width, height);
 
-      // Wobble/distortion effect (horizontal displacement)
+      // Wobble (horizontal displacement) and chromatic aberration (RGB split)
+      // share a single read-back of the canvas
       if (deg > 0.1) {
         const wobbleAmount = deg * 10 * (1 + Math.sin(wobblePhase * Math.PI * 2) * 0.5);
+        const aberration = deg > 0.2 ? Math.floor(deg * 3) : 0;
         const imageData = ctx.getImageData(0, 0, width, height);
         const data = imageData.data;
-        const tempData = new Uint8ClampedArray(data);
+        pixelScratch.set(data);
 
         for (let y = 0; y < height; y++) {
-          const lineWobble = Math.sin(y * 0.1 + t * 20) * wobbleAmount;
-          const offset = Math.floor(lineWobble);
+          const offset = Math.floor(Math.sin(y * 0.1 + t * 20) * wobbleAmount);
+          const row = y * width;
 
           for (let x = 0; x < width; x++) {
-            const srcX = Math.max(0, Math.min(width - 1, x + offset));
-            const srcIdx = (y * width + srcX) * 4;
-            const dstIdx = (y * width + x) * 4;
-
-            data[dstIdx] = tempData[srcIdx];
-            data[dstIdx + 1] = tempData[srcIdx + 1];
-            data[dstIdx + 2] = tempData[srcIdx + 2];
-            data[dstIdx + 3] = tempData[srcIdx + 3];
-          }
-        }
-        ctx.putImageData(imageData, 0, 0);
-      }
-
-      // Chromatic aberration (RGB split)
-      if (deg > 0.2) {
-        const aberration = Math.floor(deg * 3);
-        const imageData = ctx.getImageData(0, 0, width, height);
-        const data = imageData.data;
-
-        for (let i = 0; i < data.length; i += 4) {
-          const x = (i / 4) % width;
-          const y = Math.floor((i / 4) / width);
-
-          // Shift red channel left
-          const redIdx = (y * width + Math.max(0, x - aberration)) * 4;
-          // Shift blue channel right
-          const blueIdx = (y * width + Math.min(width - 1, x + aberration)) * 4;
-
-          if (redIdx >= 0 && redIdx < data.length) {
-            data[i] = data[redIdx]; // Red from shifted position
-          }
-          if (blueIdx >= 0 && blueIdx < data.length) {
-            data[i + 2] = data[blueIdx + 2]; // Blue from shifted position
+            const dstIdx = (row + x) * 4;
+            const srcIdx = (row + Math.max(0, Math.min(width - 1, x + offset))) * 4;
+
+            data[dstIdx + 1] = pixelScratch[srcIdx + 1];
+            data[dstIdx + 3] = pixelScratch[srcIdx + 3];
+
+            if (aberration > 0) {
+              // Red shifted left, blue shifted right, sampled from the wobbled image
+              const redX = Math.max(0, Math.min(width - 1, x - aberration + offset));
+              const blueX = Math.max(0, Math.min(width - 1, x + aberration + offset));
+              data[dstIdx] = pixelScratch[(row + redX) * 4];
+              data[dstIdx + 2] = pixelScratch[(row + blueX) * 4 + 2];
+            } else {
+              data[dstIdx] = pixelScratch[srcIdx];
+              data[dstIdx + 2] = pixelScratch[srcIdx + 2];
+            }
           }
         }
         ctx.putImageData(imageData, 0, 0);
@@ -268,8 +307,6 @@ export function OxideVisualizer({ mode, degradation }: OxideVisualizerProps) {
       ctx.strokeStyle = palette.accent + '20';
       ctx.lineWidth = 2;
       ctx.strokeRect(1, 1, width - 2, height - 2);
-
-      animationRef.current = requestAnimationFrame(animate);
     };
 
     animate();
@@ -279,7 +316,7 @@ export function OxideVisualizer({ mode, degradation }: OxideVisualizerProps) {
         cancelAnimationFrame(animationRef.current);
       }
     };
-  }, [mode, degradation, visualizerData]);
+  }, [mode, degradation, frameRate, waveformRef]);
 
   return (
     <div className="oxide-visualizer">
@@ -1,26 +1,23 @@
 import { useState } from 'react';
-
-const presets = [
-  { name: 'Init', category: 'Default' },
-  { name: 'Dusty Vinyl', category: 'Vinyl' },
-  { name: 'Worn Cassette', category: 'Cassette' },
-  { name: 'VHS Memories', category: 'VHS' },
-  { name: 'AM Radio', category: 'Radio' },
-  { name: 'Lo-Fi Beats', category: 'Cassette' },
-  { name: 'Old Record', category: 'Vinyl' },
-  { name: 'Tape Warble', category: 'Cassette' },
-  { name: 'Broken TV', category: 'VHS' },
-  { name: 'Subtle Warmth', category: 'Cassette' },
-];
+import { usePresets } from '../hooks/usePresets';
 
 export function PresetSelector() {
   const [isOpen, setIsOpen] = useState(false);
-  const [currentPreset, setCurrentPreset] = useState('Init');
+  const [saveName, setSaveName] = useState('');
+  const { presets, current, loadPreset, savePreset } = usePresets();
+
+  const currentName = presets.find((p) => p.index === current)?.name ?? 'Init';
 
-  const handleSelect = (preset: string) => {
-    setCurrentPreset(preset);
+  const handleSelect = (index: number) => {
+    loadPreset(index);
+    setIsOpen(false);
+  };
+
+  const handleSave = () => {
+    if (!saveName.trim()) return;
+    savePreset(saveName);
+    setSaveName('');
     setIsOpen(false);
-    // TODO: Load preset values
   };
 
   return (
@@ -30,7 +27,7 @@ export function PresetSelector() {
         onClick={() => setIsOpen(!isOpen)}
       >
         <span className="preset-label">PRESET</span>
-        <span className="preset-name">{currentPreset}</span>
+        <span className="preset-name">{currentName}</span>
         <span className="preset-arrow">{isOpen ? '▲' : '▼'}</span>
       </button>
 
@@ -38,14 +35,29 @@ export function PresetSelector() {
         <div className="preset-dropdown">
           {presets.map((preset) => (
             <button
-              key={preset.name}
-              className={`preset-item ${currentPreset === preset.name ? 'active' : ''}`}
-              onClick={() => handleSelect(preset.name)}
+              key={preset.index}
+              className={`preset-item ${current === preset.index ? 'active' : ''}`}
+              onClick={() => handleSelect(preset.index)}
             >
               <span className="preset-item-name">{preset.name}</span>
               <span className="preset-item-category">{preset.category}</span>
             </button>
           ))}
+
+          <div className="preset-save">
+            <input
+              className="preset-save-input"
+              type="text"
+              placeholder="Save as..."
+              maxLength={31}
+              value={saveName}
+              onChange={(e) => setSaveName(e.target.value)}
+              onKeyDown={(e) => { if (e.key === 'Enter') handleSave(); }}
+            />
+            <button className="preset-save-button" onClick={handleSave} disabled={!saveName.trim()}>
+              SAVE
+            </button>
+          </div>
         </div>
       )}
 
@@ -138,6 +150,46 @@ export function PresetSelector() {
           font-size: 10px;
           color: rgba(255,255,255,0.3);
         }
+
+        .preset-save {
+          display: flex;
+          gap: 6px;
+          padding: 8px 10px;
+          border-top: 1px solid rgba(255,255,255,0.08);
+        }
+
+        .preset-save-input {
+          flex: 1;
+          min-width: 0;
+          padding: 6px 8px;
+          background: rgba(0,0,0,0.3);
+          border: 1px solid rgba(255,255,255,0.08);
+          border-radius: 4px;
+          font-size: 12px;
+          color: rgba(255,255,255,0.9);
+          outline: none;
+        }
+
+        .preset-save-input:focus {
+          border-color: rgba(255,107,53,0.5);
+        }
+
+        .preset-save-button {
+          padding: 6px 10px;
+          background: rgba(255,107,53,0.15);
+          border: 1px solid rgba(255,107,53,0.3);
+          border-radius: 4px;
+          font-size: 9px;
+          font-weight: 600;
+          letter-spacing: 1px;
+          color: #ff6b35;
+          cursor: pointer;
+        }
+
+        .preset-save-button:disabled {
+          opacity: 0.4;
+          cursor: default;
+        }
       `}</style>
     </div>
   );
@@ -1,18 +1,48 @@
 /**
  * React Hooks for JUCE 8 Parameter Binding
  *
- * These hooks provide easy React integration with JUCE 8's native WebView relay system.
- * They handle bidirectional sync automatically - changes from React update JUCE,
- * and changes from JUCE (automation, presets) update React.
+ * These hooks bind React state to the batched ParameterChannel. They handle
+ * bidirectional sync automatically - changes from React update JUCE,
+ * and changes from JUCE (automation, presets) update React. A preset recall
+ * arrives as one bridge event, and React batches the resulting updates.
  */
 
 import { useState, useEffect, useCallback, useRef } from 'react';
 import {
-  getSliderState,
-  getToggleState,
+  getParameterChannel,
   isJuceEnvironment,
 } from '../lib/juce-bridge';
 
+/**
+ * Shared plumbing: current value of one parameter from the channel
+ */
+function useChannelValue<T>(
+  paramId: string,
+  defaultValue: T,
+  fromNative: (value: number) => T
+): [T, (value: T) => void] {
+  const channel = getParameterChannel();
+  const fromNativeRef = useRef(fromNative);
+  const [value, setValueState] = useState<T>(() => {
+    const current = channel.getValue(paramId);
+    return current !== undefined ? fromNative(current) : defaultValue;
+  });
+
+  useEffect(() => {
+    // Listen for changes from JUCE (automation, presets, etc.)
+    const listenerId = channel.addListener(paramId, () => {
+      const current = channel.getValue(paramId);
+      if (current !== undefined) setValueState(fromNativeRef.current(current));
+    });
+
+    return () => {
+      channel.removeListener(paramId, listenerId);
+    };
+  }, [channel, paramId]);
+
+  return [value, setValueState];
+}
+
 // ==============================================================================
 // useSliderParam - Continuous Float Parameters
 // ==============================================================================
@@ -33,47 +63,28 @@ interface SliderParamReturn {
 /**
  * Hook for continuous float parameters (gain, mix, frequency, etc.)
  *
- * @param paramId - Must match the C++ relay identifier (e.g., "gain")
+ * @param paramId - Must match the C++ ParameterIDs identifier (e.g., "gain")
  * @param defaultValue - Default value when not running in JUCE (in scaled/native range)
  */
 export function useSliderParam(
   paramId: string,
   defaultValue: number = 0.5
 ): SliderParamReturn {
-  const [value, setValueState] = useState(defaultValue);
-  const stateRef = useRef(getSliderState(paramId));
+  const [value, setValueState] = useChannelValue(paramId, defaultValue, (v) => v);
   const isConnected = isJuceEnvironment();
 
-  useEffect(() => {
-    const state = stateRef.current;
-
-    // Sync initial value from JUCE (use scaled value for display)
-    if (isConnected) {
-      setValueState(state.getScaledValue());
-    }
-
-    // Listen for changes from JUCE (automation, presets, etc.)
-    const listenerId = state.valueChangedEvent.addListener(() => {
-      setValueState(state.getScaledValue());
-    });
-
-    return () => {
-      state.valueChangedEvent.removeListener(listenerId);
-    };
-  }, [isConnected]);
-
   const setValue = useCallback((newValue: number) => {
     setValueState(newValue);
-    stateRef.current.setScaledValue(newValue);
-  }, []);
+    getParameterChannel().setValue(paramId, newValue);
+  }, [paramId, setValueState]);
 
   const dragStart = useCallback(() => {
-    stateRef.current.sliderDragStarted();
-  }, []);
+    getParameterChannel().beginGesture(paramId);
+  }, [paramId]);
 
   const dragEnd = useCallback(() => {
-    stateRef.current.sliderDragEnded();
-  }, []);
+    getParameterChannel().endGesture(paramId);
+  }, [paramId]);
 
   return { value, setValue, dragStart, dragEnd, isConnected };
 }
@@ -96,47 +107,31 @@ interface ToggleParamReturn {
 /**
  * Hook for boolean parameters (bypass, enable, etc.)
  *
- * @param paramId - Must match the C++ relay identifier (e.g., "bypass")
+ * @param paramId - Must match the C++ ParameterIDs identifier (e.g., "bypass")
  */
 export function useToggleParam(
   paramId: string,
   defaultValue: boolean = false
 ): ToggleParamReturn {
-  const [value, setValueState] = useState(defaultValue);
-  const stateRef = useRef(getToggleState(paramId));
+  const [value, setValueState] = useChannelValue(paramId, defaultValue, (v) => v >= 0.5);
+  const valueRef = useRef(value);
+  valueRef.current = value;
   const isConnected = isJuceEnvironment();
 
-  useEffect(() => {
-    const state = stateRef.current;
-
-    if (isConnected) {
-      setValueState(state.getValue());
-    }
-
-    const listenerId = state.valueChangedEvent.addListener(() => {
-      setValueState(state.getValue());
-    });
-
-    return () => {
-      state.valueChangedEvent.removeListener(listenerId);
-    };
-  }, [isConnected]);
-
   const setValue = useCallback((newValue: boolean) => {
     setValueState(newValue);
-    stateRef.current.setValue(newValue);
-  }, []);
+    getParameterChannel().setValues({ [paramId]: newValue ? 1 : 0 });
+  }, [paramId, setValueState]);
 
   const toggle = useCallback(() => {
-    const newValue = !stateRef.current.getValue();
-    setValue(newValue);
+    setValue(!valueRef.current);
   }, [setValue]);
 
   return { value, setValue, toggle, isConnected };
 }
 
 // ==============================================================================
-// useChoiceParam - Integer Choice Parameters (using slider relay)
+// useChoiceParam - Integer Choice Parameters
 // ==============================================================================
 
 interface ChoiceParamReturn {
@@ -149,10 +144,9 @@ interface ChoiceParamReturn {
 }
 
 /**
- * Hook for integer choice parameters using slider relay
- * Works with AudioParameterInt that uses WebSliderRelay
+ * Hook for integer choice parameters (AudioParameterChoice / AudioParameterInt)
  *
- * @param paramId - Must match the C++ relay identifier (e.g., "mode")
+ * @param paramId - Must match the C++ ParameterIDs identifier (e.g., "mode")
  * @param _numChoices - Number of choices (unused, for API compatibility)
  * @param defaultValue - Default value when not running in JUCE
  */
@@ -161,30 +155,13 @@ export function useChoiceParam(
   _numChoices: number,
   defaultValue: number = 0
 ): ChoiceParamReturn {
-  const [value, setValueState] = useState(defaultValue);
-  const stateRef = useRef(getSliderState(paramId));
+  const [value, setValueState] = useChannelValue(paramId, defaultValue, Math.round);
   const isConnected = isJuceEnvironment();
 
-  useEffect(() => {
-    const state = stateRef.current;
-
-    if (isConnected) {
-      setValueState(Math.round(state.getScaledValue()));
-    }
-
-    const listenerId = state.valueChangedEvent.addListener(() => {
-      setValueState(Math.round(state.getScaledValue()));
-    });
-
-    return () => {
-      state.valueChangedEvent.removeListener(listenerId);
-    };
-  }, [isConnected]);
-
   const setChoice = useCallback((newValue: number) => {
     setValueState(newValue);
-    stateRef.current.setScaledValue(newValue);
-  }, []);
+    getParameterChannel().setValues({ [paramId]: newValue });
+  }, [paramId, setValueState]);
 
   return { value, setChoice, isConnected };
 }
@@ -0,0 +1,63 @@
+import { useState, useEffect, useCallback } from 'react';
+import { isInJuceWebView, addEventListener, emitEvent } from '../lib/juce-bridge';
+
+/** BS.1770 readings for one side; -100 means silence or a window not yet full */
+export interface LoudnessReading {
+  momentary: number;   // LUFS, 400 ms
+  shortTerm: number;   // LUFS, 3 s
+  integrated: number;  // LUFS since reset
+  truePeak: number;    // dBTP, max since reset
+}
+
+export interface LoudnessData {
+  input: LoudnessReading;
+  output: LoudnessReading;
+}
+
+const silent: LoudnessReading = { momentary: -100, shortTerm: -100, integrated: -100, truePeak: -100 };
+
+const defaultData: LoudnessData = { input: silent, output: silent };
+
+export interface LoudnessControls {
+  reset: () => void;
+  /** Set the output gain so the output's short-term loudness matches the input's */
+  match: () => void;
+}
+
+/**
+ * Input and output loudness from the native meter, sent a few times a second
+ * with the telemetry.
+ */
+export function useLoudnessData(): [LoudnessData, LoudnessControls] {
+  const [data, setData] = useState<LoudnessData>(defaultData);
+
+  useEffect(() => {
+    if (!isInJuceWebView()) return;
+
+    return addEventListener('loudnessData', (eventData: unknown) => {
+      const d = eventData as Partial<LoudnessData>;
+      if (d && typeof d === 'object') {
+        setData({
+          input: { ...silent, ...d.input },
+          output: { ...silent, ...d.output }
+        });
+      }
+    });
+  }, []);
+
+  const reset = useCallback(() => {
+    if (isInJuceWebView()) {
+      emitEvent('resetLoudness', {});
+    } else {
+      setData(defaultData);
+    }
+  }, []);
+
+  const match = useCallback(() => {
+    if (isInJuceWebView()) {
+      emitEvent('matchLoudness', {});
+    }
+  }, []);
+
+  return [data, { reset, match }];
+}
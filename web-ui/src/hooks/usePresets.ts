@@ -0,0 +1,71 @@
+import { useState, useEffect, useCallback } from 'react';
+import { isInJuceWebView, addEventListener, emitEvent } from '../lib/juce-bridge';
+
+export interface PresetInfo {
+  index: number;
+  name: string;
+  category: string;
+  isFactory: boolean;
+}
+
+// Used when running outside JUCE (browser dev server)
+const demoPresets: PresetInfo[] = [
+  'Init', 'Dusty Vinyl', 'Worn Cassette', 'VHS Memories', 'AM Radio',
+  'Lo-Fi Beats', 'Old Record', 'Tape Warble', 'Broken TV', 'Subtle Warmth',
+].map((name, index) => ({
+  index,
+  name,
+  category: ['Default', 'Vinyl', 'Cassette', 'VHS', 'Radio', 'Cassette', 'Vinyl', 'Cassette', 'VHS', 'Cassette'][index],
+  isFactory: true,
+}));
+
+/**
+ * Preset list and current program, owned by the native preset bank.
+ * Loading and saving happen in C++; the UI only sends indices and names.
+ */
+export function usePresets() {
+  const [presets, setPresets] = useState<PresetInfo[]>(isInJuceWebView() ? [] : demoPresets);
+  const [current, setCurrent] = useState(0);
+
+  useEffect(() => {
+    if (!isInJuceWebView()) return;
+
+    const unsubscribe = addEventListener('presetState', (eventData: unknown) => {
+      const d = eventData as { presets?: PresetInfo[]; current?: number };
+      if (d && Array.isArray(d.presets)) setPresets(d.presets);
+      if (d && typeof d.current === 'number') setCurrent(d.current);
+    });
+
+    emitEvent('getPresets', {});
+    return unsubscribe;
+  }, []);
+
+  const loadPreset = useCallback((index: number) => {
+    if (isInJuceWebView()) {
+      emitEvent('loadPreset', { index });
+    } else {
+      setCurrent(index);
+    }
+  }, []);
+
+  const savePreset = useCallback((name: string) => {
+    const trimmed = name.trim();
+    if (!trimmed) return;
+
+    if (isInJuceWebView()) {
+      emitEvent('savePreset', { name: trimmed });
+    } else {
+      setPresets((prev) => {
+        const existing = prev.find((p) => !p.isFactory && p.name === trimmed);
+        if (existing) {
+          setCurrent(existing.index);
+          return prev;
+        }
+        setCurrent(prev.length);
+        return [...prev, { index: prev.length, name: trimmed, category: 'User', isFactory: false }];
+      });
+    }
+  }, []);
+
+  return { presets, current, loadPreset, savePreset };
+}
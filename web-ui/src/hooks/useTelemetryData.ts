@@ -0,0 +1,67 @@
+import { useState, useEffect, useCallback } from 'react';
+import { isInJuceWebView, addEventListener, emitEvent } from '../lib/juce-bridge';
+
+export interface TelemetryConfiguration {
+  mode: string;
+  crushMode: string;
+  satEngine: string;
+  blocks: number;
+  meanLoad: number;
+  peakLoad: number;
+}
+
+/** processBlock timing; loads are processing time / buffer period (1 = deadline) */
+export interface TelemetryData {
+  sampleRate: number;
+  blocks: number;
+  nearMisses: number;
+  overruns: number;
+  lastLoad: number;
+  meanLoad: number;
+  peakLoad: number;
+  binWidth: number;
+  histogram: number[];
+  configurations: TelemetryConfiguration[];
+}
+
+const defaultData: TelemetryData = {
+  sampleRate: 0,
+  blocks: 0,
+  nearMisses: 0,
+  overruns: 0,
+  lastLoad: 0,
+  meanLoad: 0,
+  peakLoad: 0,
+  binWidth: 0.05,
+  histogram: [],
+  configurations: []
+};
+
+/**
+ * Deadline telemetry from the native processor, sent a few times a second
+ * alongside the visualizer data. resetTelemetry clears the counters.
+ */
+export function useTelemetryData(): [TelemetryData, () => void] {
+  const [data, setData] = useState<TelemetryData>(defaultData);
+
+  useEffect(() => {
+    if (!isInJuceWebView()) return;
+
+    return addEventListener('telemetryData', (eventData: unknown) => {
+      const d = eventData as Partial<TelemetryData>;
+      if (d && typeof d === 'object') {
+        setData({ ...defaultData, ...d });
+      }
+    });
+  }, []);
+
+  const resetTelemetry = useCallback(() => {
+    if (isInJuceWebView()) {
+      emitEvent('resetTelemetry', {});
+    } else {
+      setData(defaultData);
+    }
+  }, []);
+
+  return [data, resetTelemetry];
+}
@@ -1,5 +1,5 @@
-import { useState, useEffect } from 'react';
-import { isInJuceWebView, addEventListener } from '../lib/juce-bridge';
+import { useState, useEffect, useCallback } from 'react';
+import { isInJuceWebView, addEventListener, emitEvent } from '../lib/juce-bridge';
 
 export interface VisualizerData {
   rms: number;
@@ -75,3 +75,46 @@ export function useVisualizerData(): VisualizerData {
 
   return data;
 }
+
+// ==============================================================================
+// Frame budget and pause/resume
+// ==============================================================================
+
+export const visualizerFrameRates = [15, 30, 60] as const;
+export type VisualizerFrameRate = typeof visualizerFrameRates[number];
+
+/**
+ * Tell C++ whether the visualizer is on screen. While paused the native
+ * timer is stopped and no visualizerData events are sent.
+ */
+export function setVisualizerActive(active: boolean): void {
+  if (!isInJuceWebView()) return;
+  emitEvent(active ? 'visualizerResume' : 'visualizerPause', {});
+}
+
+/**
+ * Hook for the user-selectable visualizer frame budget (15/30/60 Hz).
+ * The value is owned by C++ and saved with the plugin state.
+ */
+export function useVisualizerFrameRate(): [VisualizerFrameRate, (rate: VisualizerFrameRate) => void] {
+  const [frameRate, setFrameRateState] = useState<VisualizerFrameRate>(60);
+
+  useEffect(() => {
+    if (!isInJuceWebView()) return;
+
+    return addEventListener('visualizerConfig', (eventData: unknown) => {
+      const d = eventData as { frameRate?: number };
+      const rate = visualizerFrameRates.find(r => r === d?.frameRate);
+      if (rate) setFrameRateState(rate);
+    });
+  }, []);
+
+  const setFrameRate = useCallback((rate: VisualizerFrameRate) => {
+    setFrameRateState(rate);
+    if (isInJuceWebView()) {
+      emitEvent('setVisualizerRate', { frameRate: rate });
+    }
+  }, []);
+
+  return [frameRate, setFrameRate];
+}
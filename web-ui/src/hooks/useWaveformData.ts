@@ -0,0 +1,70 @@
+import { useRef, useEffect } from 'react';
+import { isInJuceWebView, addEventListener } from '../lib/juce-bridge';
+
+/**
+ * Rolling min/max history of the input (pre) and output (post) signal, one
+ * column per 1/columnRate s. Columns are stored as interleaved min/max pairs
+ * in a ring; `head` is the index of the next column to be written.
+ */
+export interface WaveformHistory {
+  columns: number;
+  pre: Float32Array;
+  post: Float32Array;
+  head: number;
+}
+
+function pushColumns(history: WaveformHistory, pre: number[], post: number[]) {
+  const count = Math.min(pre.length, post.length) >> 1;
+
+  for (let i = 0; i < count; i++) {
+    const slot = history.head * 2;
+    history.pre[slot] = pre[i * 2];
+    history.pre[slot + 1] = pre[i * 2 + 1];
+    history.post[slot] = post[i * 2];
+    history.post[slot + 1] = post[i * 2 + 1];
+    history.head = (history.head + 1) % history.columns;
+  }
+}
+
+/**
+ * Waveform columns from the native processor, batched per visualizer frame.
+ * Kept in a ref so incoming data never re-renders; read it from the draw loop.
+ */
+export function useWaveformData(columns: number) {
+  const historyRef = useRef<WaveformHistory>({
+    columns,
+    pre: new Float32Array(columns * 2),
+    post: new Float32Array(columns * 2),
+    head: 0
+  });
+
+  useEffect(() => {
+    const history = historyRef.current;
+
+    if (!isInJuceWebView()) {
+      // Demo signal when not in JUCE: a beating tone, slightly clipped on the way out
+      let t = 0;
+      const interval = window.setInterval(() => {
+        const pre: number[] = [];
+        const post: number[] = [];
+        for (let i = 0; i < 2; i++, t += 0.01) {
+          const level = 0.4 + 0.3 * Math.sin(t * 2);
+          const wet = Math.tanh(level * 1.5) * 0.8;
+          pre.push(-level, level);
+          post.push(-wet * (0.9 + Math.random() * 0.1), wet * (0.9 + Math.random() * 0.1));
+        }
+        pushColumns(history, pre, post);
+      }, 20);
+      return () => window.clearInterval(interval);
+    }
+
+    return addEventListener('waveformData', (eventData: unknown) => {
+      const d = eventData as { pre?: number[]; post?: number[] };
+      if (d && Array.isArray(d.pre) && Array.isArray(d.post)) {
+        pushColumns(history, d.pre, d.post);
+      }
+    });
+  }, []);
+
+  return historyRef;
+}
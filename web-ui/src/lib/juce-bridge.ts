@@ -411,6 +411,140 @@ export function getComboBoxState(name: string): ComboBoxState {
   return comboBoxStates.get(name)!;
 }
 
+// ==============================================================================
+// ParameterChannel - Batched Parameter Sync
+// ==============================================================================
+
+type GestureOp =
+  | { type: 'begin'; id: string }
+  | { type: 'set'; id: string; value: number }
+  | { type: 'end'; id: string };
+
+/**
+ * ParameterChannel manages all parameters over a single pair of events,
+ * matching ParameterSync on the C++ side:
+ *   - "paramBatch" (C++ -> JS): { values: { [id]: value } } for every parameter
+ *     that changed since the last message-loop tick
+ *   - "paramGestures" (JS -> C++): { ops: [...] } begin/set/end operations
+ *     collected over one animation frame
+ *
+ * Values are in each parameter's native range (choice index, bool as 0/1).
+ */
+export class ParameterChannel {
+  private values = new Map<string, number>();
+  private listeners = new Map<string, ListenerList>();
+  private pendingOps: GestureOp[] = [];
+  private flushScheduled = false;
+
+  batchReceivedEvent = new ListenerList();
+
+  constructor() {
+    if (isInJuceWebView()) {
+      window.__JUCE__!.backend.addEventListener('paramBatch', (event) =>
+        this.handleBatch(event as { values?: Record<string, number> })
+      );
+
+      // Request the full parameter state from C++
+      window.__JUCE__!.backend.emitEvent('paramSyncRequest', {});
+    }
+  }
+
+  /** Current value, or undefined before the first sync */
+  getValue(id: string): number | undefined {
+    return this.values.get(id);
+  }
+
+  /** Listen for changes to a single parameter (from host or UI) */
+  addListener(id: string, fn: ListenerCallback): number {
+    if (!this.listeners.has(id)) {
+      this.listeners.set(id, new ListenerList());
+    }
+    return this.listeners.get(id)!.addListener(fn);
+  }
+
+  removeListener(id: string, listenerId: number): void {
+    this.listeners.get(id)?.removeListener(listenerId);
+  }
+
+  /** Call when the user starts dragging (for undo grouping) */
+  beginGesture(id: string): void {
+    this.queue({ type: 'begin', id });
+  }
+
+  /** Call when the user stops dragging (for undo grouping) */
+  endGesture(id: string): void {
+    this.queue({ type: 'end', id });
+  }
+
+  /** Set a value in the parameter's native range */
+  setValue(id: string, value: number): void {
+    this.values.set(id, value);
+    this.queue({ type: 'set', id, value });
+  }
+
+  /** Set several parameters as one gesture each, sent in a single message */
+  setValues(values: Record<string, number>): void {
+    for (const [id, value] of Object.entries(values)) {
+      this.beginGesture(id);
+      this.setValue(id, value);
+      this.endGesture(id);
+    }
+  }
+
+  private queue(op: GestureOp): void {
+    // Coalesce repeated sets of the same parameter within one flush
+    const last = this.pendingOps[this.pendingOps.length - 1];
+    if (op.type === 'set' && last?.type === 'set' && last.id === op.id) {
+      last.value = op.value;
+    } else {
+      this.pendingOps.push(op);
+    }
+
+    if (!this.flushScheduled) {
+      this.flushScheduled = true;
+      if (document.hidden) {
+        setTimeout(() => this.flush(), 0);
+      } else {
+        requestAnimationFrame(() => this.flush());
+      }
+    }
+  }
+
+  private flush(): void {
+    this.flushScheduled = false;
+    if (this.pendingOps.length === 0) return;
+
+    const ops = this.pendingOps;
+    this.pendingOps = [];
+
+    if (isInJuceWebView()) {
+      window.__JUCE__!.backend.emitEvent('paramGestures', { ops });
+    }
+  }
+
+  private handleBatch(event: { values?: Record<string, number> }): void {
+    if (!event.values) return;
+
+    for (const [id, value] of Object.entries(event.values)) {
+      this.values.set(id, value);
+      this.listeners.get(id)?.callListeners();
+    }
+    this.batchReceivedEvent.callListeners();
+  }
+}
+
+let parameterChannel: ParameterChannel | null = null;
+
+/**
+ * Get the shared ParameterChannel (created on first use).
+ */
+export function getParameterChannel(): ParameterChannel {
+  if (!parameterChannel) {
+    parameterChannel = new ParameterChannel();
+  }
+  return parameterChannel;
+}
+
 // ==============================================================================
 // Custom Event Listener (for non-parameter data like visualizers)
 // ==============================================================================